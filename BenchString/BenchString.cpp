@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  BenchString.cpp
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided 
+//  the above copyright notice is retained in the resulting source code.
+// 
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConcurrentStrList.h"
+#include "ParallelStrUtil.h"
+#include "StrUtil.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace PKIsensee;
+
+// Throughput benchmarks; build Release. Each result is the best of several runs.
+
+namespace
+{
+
+constexpr size_t kRuns = 5;
+constexpr size_t kThreadCounts[] = { 1, 2, 4, 8, 16 };
+
+// Best time in seconds over kRuns calls to fn
+template< typename Fn >
+double Time( Fn fn )
+{
+  double best = 1e9;
+  for( size_t run = 0; run < kRuns; ++run )
+  {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min( best, elapsed.count() );
+  }
+  return best;
+}
+
+// Run fn( thread ) on threadCount threads and wait for all of them
+template< typename Fn >
+void RunThreads( size_t threadCount, Fn fn )
+{
+  std::vector<std::jthread> threads;
+  for( size_t t = 0; t < threadCount; ++t )
+    threads.emplace_back( fn, t );
+}
+
+} // anonymous
+
+void BenchConcurrentStrList()
+{
+  constexpr size_t kStrs = 4 * 1024 * 1024;
+  std::printf( "ConcurrentStrList::push_back vs mutex-guarded StrList::push_back (M strings/s)\n" );
+  for( auto threadCount : kThreadCounts )
+  {
+    auto perThread = kStrs / threadCount;
+    auto concurrent = Time( [&]()
+      {
+        ConcurrentStrList list;
+        RunThreads( threadCount, [&]( size_t )
+          {
+            for( size_t i = 0; i < perThread; ++i )
+              list.push_back( std::string( "benchmark" ) );
+          } );
+      } );
+    auto locked = Time( [&]()
+      {
+        StrList list;
+        std::mutex mutex;
+        RunThreads( threadCount, [&]( size_t )
+          {
+            for( size_t i = 0; i < perThread; ++i )
+            {
+              std::scoped_lock lock( mutex );
+              list.push_back( std::string( "benchmark" ) );
+            }
+          } );
+      } );
+    std::printf( "  %2zu threads: %8.1f concurrent %8.1f locked\n", threadCount,
+                 double( kStrs ) / concurrent / 1e6, double( kStrs ) / locked / 1e6 );
+  }
+}
+
+void BenchParallelStrUtil()
+{
+  StrList strList;
+  for( size_t i = 0; i < 1024 * 1024; ++i )
+    strList.push_back( "  Item <" + std::to_string( i ) + "> & Co: \"Quoted?\"  " );
+  std::string doc;
+  while( doc.size() < 64 * 1024 * 1024 )
+    doc += "<tag attr='x'>&amp;</tag> plain text plain text plain text ";
+  auto listBytes = double( strList.GetCharCount() );
+  auto docBytes = double( doc.size() );
+
+  std::printf( "ParallelStrUtil (GB/s)\n" );
+  auto serialLower = Time( [&]() { for( auto& str : strList ) StrUtil::ToLower( str ); } );
+  auto serialXml = Time( [&]() { auto xml = StrUtil::GetXmlSafe( doc ); } );
+  std::printf( "  serial:     %8.2f ToLower %8.2f GetXmlSafe\n", listBytes / serialLower / 1e9, docBytes / serialXml / 1e9 );
+  for( auto threadCount : kThreadCounts )
+  {
+    auto lower = Time( [&]() { ParallelStrUtil::ToLower( strList, threadCount ); } );
+    auto xml = Time( [&]() { auto xmlSafe = ParallelStrUtil::GetXmlSafe( doc, threadCount ); } );
+    std::printf( "  %2zu threads: %8.2f ToLower %8.2f GetXmlSafe\n", threadCount,
+                 listBytes / lower / 1e9, docBytes / xml / 1e9 );
+  }
+}
+
+// Kernels are chosen at compile time; compare builds with and without /arch:AVX2
+void BenchBase64()
+{
+  using namespace StringUtil;
+  std::vector<uint8_t> bytes( 64 * 1024 * 1024 );
+  uint32_t seed = 1;
+  for( auto& byte : bytes )
+  {
+    seed = ( seed * 1664525u ) + 1013904223u;
+    byte = static_cast<uint8_t>( seed >> 24 );
+  }
+  std::string base64( GetBase64Length( bytes.size() ), '\0' );
+  std::string hex( bytes.size() * 2, '\0' );
+  std::vector<uint8_t> decoded( bytes.size() );
+  auto byteCount = double( bytes.size() );
+
+  std::printf( "Base64 and hex (GB/s of binary data)\n" );
+  auto base64Encode = Time( [&]() { Base64Encode( bytes, base64.data() ); } );
+  auto base64Decode = Time( [&]()
+    {
+      size_t size = decoded.size();
+      Base64Decode( base64, decoded.data(), size );
+    } );
+  auto hexEncode = Time( [&]() { HexEncode( bytes, hex.data() ); } );
+  auto hexDecode = Time( [&]()
+    {
+      size_t size = decoded.size();
+      HexDecode( hex, decoded.data(), size );
+    } );
+  std::printf( "  Base64: %8.2f encode %8.2f decode\n", byteCount / base64Encode / 1e9, byteCount / base64Decode / 1e9 );
+  std::printf( "  hex:    %8.2f encode %8.2f decode\n", byteCount / hexEncode / 1e9, byteCount / hexDecode / 1e9 );
+}
+
+void BenchXmlUnescape()
+{
+  std::string plain;
+  std::string dense;
+  while( plain.size() < 64 * 1024 * 1024 )
+    plain += "<tag attr='x'>plain text plain text plain text</tag> ";
+  while( dense.size() < 64 * 1024 * 1024 )
+    dense += "&lt;tag attr=&apos;x&apos;&gt;&amp;&#x41;&#66;&quot;&#x20AC;&lt;/tag&gt; ";
+
+  std::printf( "GetXmlUnescaped (GB/s of escaped input)\n" );
+  auto plainTime = Time( [&]() { auto unescaped = StrUtil::GetXmlUnescaped( plain ); } );
+  auto denseTime = Time( [&]() { auto unescaped = StrUtil::GetXmlUnescaped( dense ); } );
+  std::printf( "  %8.2f entity-free %8.2f entity-dense\n",
+               double( plain.size() ) / plainTime / 1e9, double( dense.size() ) / denseTime / 1e9 );
+}
+
+int __cdecl main()
+{
+  BenchConcurrentStrList();
+  BenchParallelStrUtil();
+  BenchBase64();
+  BenchXmlUnescape();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
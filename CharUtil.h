@@ -19,6 +19,8 @@
 #include <climits>
 #include <locale>
 #include <ranges>
+#include <string_view>
+#include <type_traits>
 
 namespace // anonymous
 {
@@ -47,6 +49,15 @@ constexpr std::array<FileCharMap, 2> kWildcardChars =
   { '?',  ' '},
 } };
 
+// Characters that never need percent encoding in URLs: the RFC 3986 unreserved set
+constexpr std::array<bool, 128> kUrlUnreserved = []()
+{
+  std::array<bool, 128> unreserved = {};
+  for( auto c : std::string_view( "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~" ) )
+    unreserved[ static_cast<size_t>( c ) ] = true;
+  return unreserved;
+}();
+
 } // anonymous
 
 namespace PKIsensee
@@ -198,6 +209,12 @@ public:
     // Character requires no conversion
     return c;
   }
+
+  static bool IsUrlUnreserved( C c )
+  {
+    auto u = static_cast<std::make_unsigned_t<C>>( c );
+    return u < kUrlUnreserved.size() && kUrlUnreserved[ u ];
+  }
   
 private:
 
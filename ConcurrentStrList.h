@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ConcurrentStrList.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Append-only list of strings that any number of threads may push_back to concurrently without
+// locks. Each push claims a slot with a single atomic increment; storage grows in segments of
+// doubling size that are never moved, so producers never wait on each other. Once all producers
+// have finished, Seal() moves the strings into a regular StrListT.
+//
+// A push that throws, which can only happen when its segment can't be allocated, leaves its slot
+// empty; empty slots are skipped by Seal().
+
+#pragma warning(push)
+#pragma warning(disable: 4324) // structure padded due to alignment specifier; intentional
+
+template< typename C >
+class ConcurrentStrListT
+{
+private:
+
+  using strT = std::basic_string< C >;
+
+  // Slots are constructed empty when their segment is allocated, so that every slot in an
+  // allocated segment is a valid object whether or not its push succeeded
+  using Slot = std::optional< strT >;
+
+  static constexpr size_t kFirstSegmentBits = 6; // first segment holds 64 strings
+  static constexpr size_t kFirstSegmentSize = size_t( 1 ) << kFirstSegmentBits;
+  static constexpr size_t kMaxSegments = 40;
+
+public:
+
+  ConcurrentStrListT() = default;
+  ConcurrentStrListT( const ConcurrentStrListT& ) = delete;
+  ConcurrentStrListT& operator=( const ConcurrentStrListT& ) = delete;
+
+  ~ConcurrentStrListT()
+  {
+    clear();
+  }
+
+  // Thread-safe. Only the segment allocation can throw; filling the slot cannot.
+  void push_back( strT str )
+  {
+    auto index = count_.fetch_add( 1, std::memory_order_relaxed );
+    auto [segment, offset] = Locate( index );
+    GetSegment( segment )[ offset ].emplace( std::move( str ) );
+  }
+
+  // Number of pushes, including any that threw. Exact once producers have finished; a lower bound
+  // while they're running.
+  size_t size() const
+  {
+    return count_.load( std::memory_order_relaxed );
+  }
+
+  // The remaining functions must not run concurrently with push_back(). Joining the producer
+  // threads before calling them is sufficient.
+
+  // Move all strings, in slot order, onto the end of strList and leave this list empty
+  void Seal( StrListT<C>& strList )
+  {
+    auto count = count_.load( std::memory_order_acquire );
+    strList.reserve( strList.size() + count );
+    ForEachSegment( count, [&strList]( Slot* first, Slot* last )
+      {
+        for( auto slot = first; slot != last; ++slot )
+        {
+          if( slot->has_value() )
+            strList.push_back( std::move( **slot ) );
+        }
+      } );
+    clear();
+  }
+
+  StrListT<C> Seal()
+  {
+    StrListT<C> strList;
+    Seal( strList );
+    return strList;
+  }
+
+  void clear()
+  {
+    for( size_t segment = 0; segment < kMaxSegments; ++segment )
+    {
+      Slot* slots = segments_[ segment ].exchange( nullptr, std::memory_order_acq_rel );
+      if( slots != nullptr )
+        FreeSegment( slots, segment );
+    }
+    count_.store( 0, std::memory_order_release );
+  }
+
+private:
+
+  static constexpr size_t GetSegmentSize( size_t segment )
+  {
+    return kFirstSegmentSize << segment;
+  }
+
+  // Segment k holds slots [ 64 * (2^k - 1), 64 * (2^(k+1) - 1) )
+  static std::pair<size_t, size_t> Locate( size_t index )
+  {
+    auto biased = index + kFirstSegmentSize;
+    auto msb = static_cast<size_t>( std::bit_width( biased ) ) - 1;
+    assert( msb - kFirstSegmentBits < kMaxSegments );
+    return { msb - kFirstSegmentBits, biased - ( size_t( 1 ) << msb ) };
+  }
+
+  // Allocate on first use; if two threads race, the loser frees its allocation
+  Slot* GetSegment( size_t segment )
+  {
+    Slot* slots = segments_[ segment ].load( std::memory_order_acquire );
+    if( slots != nullptr )
+      return slots;
+
+    Slot* fresh = std::allocator<Slot>().allocate( GetSegmentSize( segment ) );
+    std::uninitialized_value_construct_n( fresh, GetSegmentSize( segment ) );
+    if( segments_[ segment ].compare_exchange_strong( slots, fresh, std::memory_order_acq_rel,
+                                                      std::memory_order_acquire ) )
+      return fresh;
+    FreeSegment( fresh, segment );
+    return slots;
+  }
+
+  static void FreeSegment( Slot* slots, size_t segment )
+  {
+    std::destroy_n( slots, GetSegmentSize( segment ) );
+    std::allocator<Slot>().deallocate( slots, GetSegmentSize( segment ) );
+  }
+
+  // Invoke fn( first, last ) for the claimed slots of each segment. A segment whose allocation
+  // failed may be missing.
+  template< typename Fn >
+  void ForEachSegment( size_t count, Fn fn )
+  {
+    for( size_t segment = 0, start = 0; start < count; ++segment )
+    {
+      Slot* slots = segments_[ segment ].load( std::memory_order_acquire );
+      auto used = std::min( GetSegmentSize( segment ), count - start );
+      if( slots != nullptr )
+        fn( slots, slots + used );
+      start += used;
+    }
+  }
+
+private:
+
+  alignas( 64 ) std::atomic<size_t> count_ = 0;
+  alignas( 64 ) std::array<std::atomic<Slot*>, kMaxSegments> segments_ = {};
+
+}; // ConcurrentStrListT
+
+#pragma warning(pop)
+
+using ConcurrentStrList = ConcurrentStrListT<char>;
+using ConcurrentStrListW = ConcurrentStrListT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
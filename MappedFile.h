@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  MappedFile.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <utility>
+
+#if defined( _WIN32 )
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Read-only memory mapping of an entire file. The mapped bytes remain valid until the object is
+// closed or destroyed; moving the object does not change the address of the mapping.
+
+class MappedFile
+{
+public:
+
+  MappedFile() = default;
+  MappedFile( const MappedFile& ) = delete;
+  MappedFile& operator=( const MappedFile& ) = delete;
+
+  explicit MappedFile( const std::filesystem::path& path )
+  {
+    Open( path );
+  }
+
+  MappedFile( MappedFile&& rhs ) noexcept
+  {
+    Swap( rhs );
+  }
+
+  MappedFile& operator=( MappedFile&& rhs ) noexcept
+  {
+    if( this != &rhs )
+    {
+      Close();
+      Swap( rhs );
+    }
+    return *this;
+  }
+
+  ~MappedFile()
+  {
+    Close();
+  }
+
+  // Map the file; returns false if the file can't be opened or mapped. An empty file is
+  // opened successfully with no data.
+  bool Open( const std::filesystem::path& path )
+  {
+    Close();
+
+#if defined( _WIN32 )
+    file_ = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if( file_ == INVALID_HANDLE_VALUE )
+      return false;
+
+    LARGE_INTEGER fileSize = {};
+    if( !GetFileSizeEx( file_, &fileSize ) )
+    {
+      Close();
+      return false;
+    }
+    size_ = static_cast<size_t>( fileSize.QuadPart );
+    isOpen_ = true;
+    if( size_ == 0 )
+      return true;
+
+    mapping_ = CreateFileMappingW( file_, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( mapping_ != nullptr )
+      data_ = MapViewOfFile( mapping_, FILE_MAP_READ, 0, 0, 0 );
+#else
+    file_ = open( path.c_str(), O_RDONLY );
+    if( file_ < 0 )
+      return false;
+
+    struct stat fileStat = {};
+    if( fstat( file_, &fileStat ) != 0 )
+    {
+      Close();
+      return false;
+    }
+    size_ = static_cast<size_t>( fileStat.st_size );
+    isOpen_ = true;
+    if( size_ == 0 )
+      return true;
+
+    void* data = mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0 );
+    if( data != MAP_FAILED )
+    {
+      data_ = data;
+      madvise( data, size_, MADV_SEQUENTIAL );
+    }
+#endif
+
+    if( data_ == nullptr )
+    {
+      Close();
+      return false;
+    }
+    return true;
+  }
+
+  void Close()
+  {
+#if defined( _WIN32 )
+    if( data_ != nullptr )
+      UnmapViewOfFile( data_ );
+    if( mapping_ != nullptr )
+      CloseHandle( mapping_ );
+    if( file_ != INVALID_HANDLE_VALUE )
+      CloseHandle( file_ );
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+#else
+    if( data_ != nullptr )
+      munmap( const_cast<void*>( data_ ), size_ );
+    if( file_ >= 0 )
+      close( file_ );
+    file_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    isOpen_ = false;
+  }
+
+  bool IsOpen() const { return isOpen_; }
+  const void* GetData() const { return data_; }
+  size_t GetSize() const { return size_; }
+
+private:
+
+  void Swap( MappedFile& rhs ) noexcept
+  {
+    std::swap( data_, rhs.data_ );
+    std::swap( size_, rhs.size_ );
+    std::swap( isOpen_, rhs.isOpen_ );
+    std::swap( file_, rhs.file_ );
+#if defined( _WIN32 )
+    std::swap( mapping_, rhs.mapping_ );
+#endif
+  }
+
+private:
+
+  const void* data_   = nullptr;
+  size_t      size_   = 0;
+  bool        isOpen_ = false;
+
+#if defined( _WIN32 )
+  HANDLE file_    = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#else
+  int    file_    = -1;
+#endif
+
+}; // class MappedFile
+
+} // namespace PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
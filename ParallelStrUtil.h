@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  ParallelStrUtil.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Multithreaded versions of the StrUtilT transforms for large lists and strings. Work is divided
+// into chunks of roughly equal character count, several per thread, and threads claim chunks from
+// a shared counter until none remain, so a thread that finishes early takes over work that would
+// otherwise wait. The calling thread participates. Small inputs are processed on the calling
+// thread alone.
+//
+// A threadCount of zero uses every hardware thread. Strings are modified in place using their own
+// allocator, which must therefore be safe to use from multiple threads. If any thread throws, the
+// remaining chunks are abandoned and the first exception is rethrown on the calling thread once
+// every thread has stopped; a list may then be partially transformed.
+
+template< typename C >
+class ParallelStrUtilT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+  using strUtilT = StrUtilT< C >;
+
+  static constexpr size_t kMinChunkChars = 16 * 1024;
+  static constexpr size_t kChunksPerThread = 8;
+
+public:
+
+  template< typename A >
+  static void ToLower( StrListT<C, A>& strList, size_t threadCount = 0 )
+  {
+    Transform( strList, []( auto& str ) { strUtilT::ToLower( str ); }, threadCount );
+  }
+
+  template< typename A >
+  static void ToUpper( StrListT<C, A>& strList, size_t threadCount = 0 )
+  {
+    Transform( strList, []( auto& str ) { strUtilT::ToUpper( str ); }, threadCount );
+  }
+
+  template< typename A >
+  static void ToTrimmed( StrListT<C, A>& strList, viewT trimCharset, size_t threadCount = 0 )
+  {
+    Transform( strList, [trimCharset]( auto& str ) { strUtilT::ToTrimmed( str, trimCharset ); }, threadCount );
+  }
+
+  template< typename A >
+  static void ToGoodFileName( StrListT<C, A>& strList, typename strUtilT::ConvertWildcards convertWildcards,
+                              size_t threadCount = 0 )
+  {
+    Transform( strList, [convertWildcards]( auto& str ) { strUtilT::ToGoodFileName( str, convertWildcards ); }, threadCount );
+  }
+
+  template< typename A >
+  static void ToXmlSafe( StrListT<C, A>& strList, size_t threadCount = 0 )
+  {
+    Transform( strList, []( auto& str ) { strUtilT::ToXmlSafe( str ); }, threadCount );
+  }
+
+  // Escape one large string; the result is identical to StrUtilT::GetXmlSafe. Each chunk's escaped
+  // length is measured concurrently, a prefix sum gives each chunk its output offset, and then
+  // every chunk is escaped directly into its place in the preallocated result.
+  static strT GetXmlSafe( viewT str, size_t threadCount = 0 )
+  {
+    threadCount = GetThreadCount( threadCount, str.size() );
+    size_t chunkSize = std::max( str.size() / ( threadCount * kChunksPerThread ), kMinChunkChars );
+    size_t chunkCount = ( str.size() + chunkSize - 1 ) / chunkSize;
+    auto getChunk = [&]( size_t chunk ) { return str.substr( chunk * chunkSize, chunkSize ); };
+
+    // offsets[ i + 1 ] starts as the length of chunk i
+    std::vector<size_t> offsets( chunkCount + 1 );
+    RunChunks( chunkCount, threadCount, [&]( size_t chunk )
+      {
+        offsets[ chunk + 1 ] = strUtilT::GetXmlSafeLength( getChunk( chunk ) );
+      } );
+    std::inclusive_scan( offsets.begin(), offsets.end(), offsets.begin() );
+
+    strT result;
+    result.resize_and_overwrite( offsets.back(), [&]( C* out, size_t size )
+      {
+        RunChunks( chunkCount, threadCount, [&]( size_t chunk )
+          {
+            strUtilT::CopyXmlSafe( getChunk( chunk ), out + offsets[ chunk ] );
+          } );
+        return size;
+      } );
+    return result;
+  }
+
+  // Call fn( str ) on every string in the list; fn is called concurrently
+  template< typename A, typename Fn >
+  static void Transform( StrListT<C, A>& strList, Fn fn, size_t threadCount = 0 )
+  {
+    // Each string is weighted by its length plus one, so that lists of empty strings still divide
+    size_t totalWeight = strList.GetCharCount() + strList.size();
+    threadCount = GetThreadCount( threadCount, totalWeight );
+    size_t chunkWeight = std::max( totalWeight / ( threadCount * kChunksPerThread ), kMinChunkChars );
+
+    std::vector<size_t> bounds = { 0 };
+    size_t weight = 0;
+    size_t index = 0;
+    for( const auto& str : strList )
+    {
+      weight += str.size() + 1;
+      ++index;
+      if( weight >= chunkWeight )
+      {
+        bounds.push_back( index );
+        weight = 0;
+      }
+    }
+    if( bounds.back() != index )
+      bounds.push_back( index );
+
+    auto first = strList.begin();
+    RunChunks( bounds.size() - 1, threadCount, [&]( size_t chunk )
+      {
+        for( auto i = bounds[ chunk ]; i < bounds[ chunk + 1 ]; ++i )
+          fn( first[ static_cast<ptrdiff_t>( i ) ] );
+      } );
+  }
+
+private:
+
+  // Threads requested, limited so that every thread has at least one minimum-sized chunk
+  static size_t GetThreadCount( size_t threadCount, size_t totalWeight )
+  {
+    if( threadCount == 0 )
+      threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+    return std::clamp( totalWeight / kMinChunkChars, size_t( 1 ), threadCount );
+  }
+
+  // Call fn( chunk ) for every chunk in [0, chunkCount) across threadCount threads
+  template< typename Fn >
+  static void RunChunks( size_t chunkCount, size_t threadCount, Fn fn )
+  {
+    std::atomic<size_t> nextChunk = 0;
+    std::atomic<bool> hasError = false;
+    std::exception_ptr error;
+    auto worker = [&]()
+      {
+        try
+        {
+          for( auto chunk = nextChunk.fetch_add( 1, std::memory_order_relaxed ); chunk < chunkCount;
+               chunk = nextChunk.fetch_add( 1, std::memory_order_relaxed ) )
+            fn( chunk );
+        }
+        catch( ... )
+        {
+          // Keep the first exception and stop other threads from claiming more chunks
+          if( !hasError.exchange( true ) )
+            error = std::current_exception();
+          nextChunk.store( chunkCount, std::memory_order_relaxed );
+        }
+      };
+
+    {
+      std::vector<std::jthread> threads;
+      threadCount = std::min( threadCount, chunkCount );
+      for( size_t i = 1; i < threadCount; ++i )
+        threads.emplace_back( worker );
+      worker();
+    }
+    if( error )
+      std::rethrow_exception( error );
+  }
+
+}; // ParallelStrUtilT
+
+using ParallelStrUtil = ParallelStrUtilT<char>;
+using ParallelStrUtilW = ParallelStrUtilT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StaticStrSet.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Fixed set of strings with a perfect hash table built entirely at compile time, for keyword and
+// reserved-name lists. Lookup is one string hash, two table reads and a single string compare.
+//
+//    constexpr auto kKeywords = MakeStaticStrSet( "if", "else", "while" );
+//    if( kKeywords.find( token ) ) ...
+//
+// Construction uses hash-and-displace: keys are hashed into groups, and each group, largest first,
+// is given the smallest displacement that moves all of its keys into free slots.
+
+template< typename C, size_t N >
+class StaticStrSetT
+{
+private:
+
+  using viewT = std::basic_string_view< C >;
+
+  static_assert( N > 0, "StaticStrSetT requires at least one key" );
+
+  static constexpr size_t kGroups = std::bit_ceil( N );
+  static constexpr size_t kSlots = std::bit_ceil( N * 2 );
+  static constexpr uint32_t kMaxDisplacement = 1u << 16;
+  static constexpr uint64_t kGroupSalt = 0x9E3779B97F4A7C15ull;
+
+public:
+
+  static constexpr size_t npos = size_t( -1 );
+
+  consteval explicit StaticStrSetT( const std::array<viewT, N>& keys ) :
+    keys_( keys )
+  {
+    std::array<uint64_t, N> hashes = {};
+    std::array<size_t, N> order = {};
+    for( size_t i = 0; i < N; ++i )
+    {
+      hashes[ i ] = StringUtil::GetHash( keys[ i ] );
+      order[ i ] = i;
+    }
+
+    // Sort keys by group, largest groups first
+    std::array<size_t, kGroups> groupSizes = {};
+    for( auto hash : hashes )
+      ++groupSizes[ GetGroup( hash ) ];
+    std::sort( order.begin(), order.end(), [&]( size_t lhs, size_t rhs )
+      {
+        auto lhsGroup = GetGroup( hashes[ lhs ] );
+        auto rhsGroup = GetGroup( hashes[ rhs ] );
+        if( groupSizes[ lhsGroup ] != groupSizes[ rhsGroup ] )
+          return groupSizes[ lhsGroup ] > groupSizes[ rhsGroup ];
+        return lhsGroup < rhsGroup;
+      } );
+
+    for( size_t first = 0; first < N; )
+    {
+      auto group = GetGroup( hashes[ order[ first ] ] );
+      size_t last = first + groupSizes[ group ];
+
+      for( size_t i = first; i < last; ++i )
+        for( size_t j = i + 1; j < last; ++j )
+          if( keys[ order[ i ] ] == keys[ order[ j ] ] )
+            throw std::logic_error( "StaticStrSetT keys must be unique" );
+
+      for( uint32_t displacement = 0; ; ++displacement )
+      {
+        if( displacement == kMaxDisplacement )
+          throw std::logic_error( "StaticStrSetT perfect hash not found" );
+        if( TryPlace( hashes, order, first, last, displacement ) )
+        {
+          displacements_[ group ] = displacement;
+          break;
+        }
+      }
+      first = last;
+    }
+  }
+
+  // Index of str in the original key list, or npos
+  constexpr size_t GetIndex( viewT str ) const
+  {
+    auto hash = StringUtil::GetHash( str );
+    auto slot = slots_[ GetSlot( hash, displacements_[ GetGroup( hash ) ] ) ];
+    if( slot == 0 || keys_[ slot - 1 ] != str )
+      return npos;
+    return slot - 1;
+  }
+
+  constexpr bool find( viewT str ) const
+  {
+    return GetIndex( str ) != npos;
+  }
+
+  constexpr bool contains( viewT str ) const
+  {
+    return find( str );
+  }
+
+  constexpr auto begin() const { return keys_.begin(); }
+  constexpr auto end() const { return keys_.end(); }
+  constexpr size_t size() const { return N; }
+
+private:
+
+  static constexpr size_t GetGroup( uint64_t hash )
+  {
+    return static_cast<size_t>( StringUtil::MixHash( hash ^ kGroupSalt ) & ( kGroups - 1 ) );
+  }
+
+  static constexpr size_t GetSlot( uint64_t hash, uint32_t displacement )
+  {
+    return static_cast<size_t>( StringUtil::MixHash( hash + displacement ) & ( kSlots - 1 ) );
+  }
+
+  // Place keys order[first, last) with the given displacement if every one lands in a free slot
+  constexpr bool TryPlace( const std::array<uint64_t, N>& hashes, const std::array<size_t, N>& order,
+                           size_t first, size_t last, uint32_t displacement )
+  {
+    for( size_t i = first; i < last; ++i )
+    {
+      auto slot = GetSlot( hashes[ order[ i ] ], displacement );
+      if( slots_[ slot ] != 0 )
+      {
+        for( size_t j = first; j < i; ++j )
+          slots_[ GetSlot( hashes[ order[ j ] ], displacement ) ] = 0;
+        return false;
+      }
+      slots_[ slot ] = static_cast<uint32_t>( order[ i ] + 1 );
+    }
+    return true;
+  }
+
+private:
+
+  std::array<viewT, N>           keys_;
+  std::array<uint32_t, kGroups>  displacements_ = {};
+  std::array<uint32_t, kSlots>   slots_ = {};    // key index + 1, or 0 if empty
+
+}; // StaticStrSetT
+
+// The character type is taken from the first key
+template< typename First, typename... Rest >
+consteval auto MakeStaticStrSet( First first, Rest... rest )
+{
+  using C = std::remove_cvref_t< decltype( *first ) >;
+  using viewT = std::basic_string_view< C >;
+  return StaticStrSetT< C, 1 + sizeof...( Rest ) >( std::array<viewT, 1 + sizeof...( Rest )>{ viewT( first ), viewT( rest )... } );
+}
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
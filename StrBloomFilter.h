@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrBloomFilter.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Blocked Bloom filter over strings. All of the bits for a string live in a single 64-byte block,
+// so MayContain() touches exactly one cache line. A false result is definitive; a true result
+// means the string is present with probability 1 - false positive rate.
+
+template< typename C >
+class StrBloomFilterT
+{
+private:
+
+  using viewT = std::basic_string_view< C >;
+
+  static constexpr size_t kBlockBits = 512;
+  static constexpr size_t kMaxHashes = 16;
+
+  struct alignas( 64 ) Block
+  {
+    uint64_t words[ kBlockBits / 64 ];
+  };
+
+public:
+
+  // Size the filter for expectedCount strings at the given false positive rate (0 < rate < 1).
+  // The filter keeps no copy of the strings, so it can't grow: adding more than expectedCount
+  // strings raises the false positive rate above the target; at a 1% target, 30% more strings
+  // roughly triples it. FilteredStrListT rebuilds its filter as it grows.
+  explicit StrBloomFilterT( size_t expectedCount, double falsePositiveRate = 0.01 )
+  {
+    falsePositiveRate = std::clamp( falsePositiveRate, 1e-9, 0.5 );
+    const double kLn2 = 0.69314718055994530942;
+    double bitsPerString = -std::log( falsePositiveRate ) / ( kLn2 * kLn2 );
+    hashCount_ = std::clamp( static_cast<size_t>( std::lround( bitsPerString * kLn2 ) ), size_t( 1 ), kMaxHashes );
+
+    auto bits = static_cast<size_t>( std::ceil( bitsPerString * static_cast<double>( std::max( expectedCount, size_t( 1 ) ) ) ) );
+    blocks_.resize( ( bits + kBlockBits - 1 ) / kBlockBits, Block{} );
+  }
+
+  void Add( viewT str )
+  {
+    auto hash = GetHash( str );
+    auto& block = blocks_[ GetBlock( hash ) ];
+    ForEachBit( hash, [&block]( size_t bit ) { block.words[ bit / 64 ] |= uint64_t( 1 ) << ( bit % 64 ); } );
+  }
+
+  bool MayContain( viewT str ) const
+  {
+    auto hash = GetHash( str );
+    const auto& block = blocks_[ GetBlock( hash ) ];
+    bool allSet = true;
+    ForEachBit( hash, [&block, &allSet]( size_t bit ) { allSet &= ( ( block.words[ bit / 64 ] >> ( bit % 64 ) ) & 1 ) != 0; } );
+    return allSet;
+  }
+
+  void clear()
+  {
+    std::ranges::fill( blocks_, Block{} );
+  }
+
+  // Bytes of filter storage
+  size_t GetMemoryUsed() const
+  {
+    return blocks_.size() * sizeof( Block );
+  }
+
+  size_t GetHashCount() const
+  {
+    return hashCount_;
+  }
+
+private:
+
+  static uint64_t GetHash( viewT str )
+  {
+    return StringUtil::MixHash( StringUtil::GetHash( str ) );
+  }
+
+  // Upper 32 bits select the block without a division
+  size_t GetBlock( uint64_t hash ) const
+  {
+    return static_cast<size_t>( ( ( hash >> 32 ) * blocks_.size() ) >> 32 );
+  }
+
+  // Lower 32 bits generate the bit positions within the block by double hashing
+  template< typename Fn >
+  void ForEachBit( uint64_t hash, Fn fn ) const
+  {
+    auto h1 = static_cast<uint32_t>( hash );
+    auto h2 = static_cast<uint32_t>( ( hash >> 16 ) | 1 );
+    for( size_t i = 0; i < hashCount_; ++i )
+    {
+      fn( static_cast<size_t>( h1 % kBlockBits ) );
+      h1 += h2;
+    }
+  }
+
+private:
+
+  std::vector<Block> blocks_;
+  size_t             hashCount_;
+
+}; // StrBloomFilterT
+
+using StrBloomFilter = StrBloomFilterT<char>;
+using StrBloomFilterW = StrBloomFilterT<wchar_t>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StrListT with a Bloom filter maintained alongside, so that find() answers most misses from the
+// filter without touching the strings. Strings can only be added, never modified in place.
+// When the list outgrows the filter, the filter is rebuilt at twice the size, so the false
+// positive rate stays near its target at an amortized constant cost per string.
+
+template< typename C >
+class FilteredStrListT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+  using strListT = StrListT< C >;
+
+public:
+
+  using value_type      = typename strListT::value_type;
+  using size_type       = typename strListT::size_type;
+  using const_iterator  = typename strListT::const_iterator;
+  using iterator        = const_iterator;
+  using const_reference = typename strListT::const_reference;
+
+public:
+
+  // The filter is sized for expectedCount strings and rebuilt if more are added
+  explicit FilteredStrListT( size_t expectedCount, double falsePositiveRate = 0.01 ) :
+    filter_( expectedCount, falsePositiveRate ),
+    filterCapacity_( std::max( expectedCount, size_t( 1 ) ) ),
+    falsePositiveRate_( falsePositiveRate )
+  {
+  }
+
+  explicit FilteredStrListT( const strListT& strList, double falsePositiveRate = 0.01 ) :
+    list_( strList ),
+    filter_( strList.size(), falsePositiveRate ),
+    filterCapacity_( std::max( strList.size(), size_t( 1 ) ) ),
+    falsePositiveRate_( falsePositiveRate )
+  {
+    for( const auto& str : list_ )
+      filter_.Add( str );
+  }
+
+  const_iterator begin() const  { return list_.begin(); }
+  const_iterator end() const    { return list_.end(); }
+  const_reference front() const { return list_.front(); }
+
+  bool empty() const     { return list_.empty(); }
+  size_type size() const { return list_.size(); }
+
+  void push_back( const strT& str )
+  {
+    list_.push_back( str );
+    if( list_.size() > filterCapacity_ )
+      Rebuild( filterCapacity_ * 2 );
+    else
+      filter_.Add( str );
+  }
+
+  void clear()
+  {
+    filter_.clear();
+    list_.clear();
+  }
+
+  bool find( viewT str ) const
+  {
+    if( !filter_.MayContain( str ) )
+      return false;
+    return std::ranges::contains( list_, str );
+  }
+
+  bool ContainsEmptyStrings() const { return list_.ContainsEmptyStrings(); }
+  size_t GetCharCount() const { return list_.GetCharCount(); }
+
+  const strListT& GetStrList() const { return list_; }
+  const StrBloomFilterT<C>& GetFilter() const { return filter_; }
+
+private:
+
+  void Rebuild( size_t capacity )
+  {
+    StrBloomFilterT<C> filter( capacity, falsePositiveRate_ );
+    for( const auto& str : list_ )
+      filter.Add( str );
+    filter_ = std::move( filter );
+    filterCapacity_ = capacity;
+  }
+
+private:
+
+  strListT           list_;
+  StrBloomFilterT<C> filter_;
+  size_t             filterCapacity_;      // strings the filter was sized for
+  double             falsePositiveRate_;
+
+}; // FilteredStrListT
+
+using FilteredStrList = FilteredStrListT<char>;
+using FilteredStrListW = FilteredStrListT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
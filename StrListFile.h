@@ -0,0 +1,355 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrListFile.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+#include "StrUtil.h"
+
+namespace // anonymous
+{
+
+// Binary StrListT image. All values are in native byte order; the file is meant to be
+// reloaded on the machine that wrote it.
+//
+//    StrListFileHeader
+//    uint64_t offsets[ count + 1 ]     character offset of each string in the blob
+//    C        blob[ charCount ]        all strings, back to back, no terminators
+//    padding to 8 bytes
+//    uint32_t buckets[ hashBuckets ]   optional; index+1 of string in slot, 0 if empty
+//
+// The checksum is a FNV-1a hash of every byte following the header.
+
+struct StrListFileHeader
+{
+  uint32_t magic;         // kStrListFileMagic
+  uint16_t version;       // kStrListFileVersion
+  uint16_t charSize;      // sizeof( C )
+  uint64_t count;         // number of strings
+  uint64_t charCount;     // total characters in blob
+  uint64_t hashBuckets;   // power of two, or zero if there is no hash index
+  uint64_t checksum;      // zero if not computed
+  uint32_t flags;         // kStrListFileChecksum if checksum is valid
+  uint32_t reserved;
+};
+
+constexpr uint32_t kStrListFileMagic = 0x4C534B50; // "PKSL"
+constexpr uint16_t kStrListFileVersion = 1;
+constexpr uint32_t kStrListFileChecksum = 0x1;
+
+constexpr uint64_t GetStrListFilePadding( uint64_t bytes )
+{
+  return ( 8 - ( bytes % 8 ) ) % 8;
+}
+
+} // anonymous
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Memory-mapped, read-only StrListT image. Open() validates the header and maps the file;
+// strings are then used in place, without parsing or allocation. Write() creates the file.
+
+template< typename C >
+class StrListFileT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+
+public:
+
+  enum class HashIndex
+  {
+    No,
+    Yes
+  };
+
+  enum class Checksum
+  {
+    No,
+    Yes
+  };
+
+  class const_iterator
+  {
+  public:
+
+    using value_type       = viewT;
+    using difference_type  = std::ptrdiff_t;
+    using iterator_concept = std::forward_iterator_tag;
+
+    const_iterator() = default;
+    const_iterator( const StrListFileT* file, size_t index ) : file_( file ), index_( index ) {}
+
+    viewT operator*() const { return ( *file_ )[ index_ ]; }
+    const_iterator& operator++() { ++index_; return *this; }
+    const_iterator operator++( int ) { auto prev( *this ); ++index_; return prev; }
+    bool operator==( const const_iterator& rhs ) const { return index_ == rhs.index_; }
+
+  private:
+
+    const StrListFileT* file_ = nullptr;
+    size_t index_ = 0;
+
+  }; // const_iterator
+
+  using value_type = viewT;
+  using size_type = size_t;
+  using iterator = const_iterator;
+
+public:
+
+  StrListFileT() = default;
+  StrListFileT( const StrListFileT& ) = delete;
+  StrListFileT( StrListFileT&& ) = default;
+  StrListFileT& operator=( const StrListFileT& ) = delete;
+  StrListFileT& operator=( StrListFileT&& ) = default;
+
+  // Write strList to path. Returns false on I/O failure or if the list is too large to index.
+  static bool Write( const StrListT<C>& strList, const std::filesystem::path& path,
+                     HashIndex hashIndex = HashIndex::Yes, Checksum checksum = Checksum::Yes )
+  {
+    StrListFileHeader header = {};
+    header.magic = kStrListFileMagic;
+    header.version = kStrListFileVersion;
+    header.charSize = sizeof( C );
+    header.count = strList.size();
+    header.charCount = strList.GetCharCount();
+    if( hashIndex == HashIndex::Yes )
+    {
+      if( strList.size() >= std::numeric_limits<uint32_t>::max() / 2 )
+        return false;
+      header.hashBuckets = 1;
+      while( header.hashBuckets < strList.size() * 2 )
+        header.hashBuckets *= 2;
+    }
+
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    if( !file )
+      return false;
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+
+    // Everything after the header is folded into the checksum as it's written
+    uint64_t hash = StringUtil::kHashSeed;
+    auto put = [&file, &hash]( const void* data, size_t bytes )
+      {
+        std::string_view raw( static_cast<const char*>( data ), bytes );
+        hash = StringUtil::GetHash( raw, hash );
+        file.write( raw.data(), static_cast<std::streamsize>( raw.size() ) );
+      };
+
+    uint64_t offset = 0;
+    for( const auto& str : strList )
+    {
+      put( &offset, sizeof( offset ) );
+      offset += str.size();
+    }
+    put( &offset, sizeof( offset ) );
+
+    for( const auto& str : strList )
+      put( str.data(), str.size() * sizeof( C ) );
+
+    const uint64_t kZero = 0;
+    put( &kZero, GetStrListFilePadding( header.charCount * sizeof( C ) ) );
+
+    if( header.hashBuckets != 0 )
+    {
+      std::vector<uint32_t> buckets( header.hashBuckets, 0u );
+      uint32_t index = 0;
+      for( const auto& str : strList )
+      {
+        ++index;
+        auto slot = StringUtil::GetHash( viewT( str ) ) & ( header.hashBuckets - 1 );
+        while( buckets[ slot ] != 0 )
+          slot = ( slot + 1 ) & ( header.hashBuckets - 1 );
+        buckets[ slot ] = index;
+      }
+      put( buckets.data(), buckets.size() * sizeof( uint32_t ) );
+    }
+
+    if( checksum == Checksum::Yes )
+    {
+      header.checksum = hash;
+      header.flags |= kStrListFileChecksum;
+      file.seekp( 0 );
+      file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    }
+    return !!file.flush();
+  }
+
+  // Map the file at path. Returns false if it can't be mapped or isn't a valid image for C.
+  // The offsets and hash index are always checked, so a corrupt image can't cause reads outside
+  // the file. Verifying the checksum reads every page of the file, so it's optional.
+  bool Open( const std::filesystem::path& path, Checksum verifyChecksum = Checksum::No )
+  {
+    Close();
+    if( !file_.Open( path ) || file_.GetSize() < sizeof( StrListFileHeader ) )
+    {
+      Close();
+      return false;
+    }
+
+    const auto* base = static_cast<const char*>( file_.GetData() );
+    std::memcpy( &header_, base, sizeof( header_ ) );
+    if( header_.magic != kStrListFileMagic || header_.version != kStrListFileVersion ||
+        header_.charSize != sizeof( C ) || header_.count >= std::numeric_limits<uint32_t>::max() ||
+        header_.charCount > file_.GetSize() || header_.hashBuckets > file_.GetSize() )
+    {
+      Close();
+      return false;
+    }
+
+    // Validate the section sizes before touching them
+    uint64_t offsetBytes = ( header_.count + 1 ) * sizeof( uint64_t );
+    uint64_t blobBytes = header_.charCount * sizeof( C );
+    uint64_t expected = sizeof( StrListFileHeader ) + offsetBytes + blobBytes +
+                        GetStrListFilePadding( blobBytes ) + header_.hashBuckets * sizeof( uint32_t );
+    if( expected != file_.GetSize() )
+    {
+      Close();
+      return false;
+    }
+
+    if( verifyChecksum == Checksum::Yes )
+    {
+      std::string_view payload( base + sizeof( StrListFileHeader ), file_.GetSize() - sizeof( StrListFileHeader ) );
+      if( !( header_.flags & kStrListFileChecksum ) || StringUtil::GetHash( payload ) != header_.checksum )
+      {
+        Close();
+        return false;
+      }
+    }
+
+    offsets_ = reinterpret_cast<const uint64_t*>( base + sizeof( StrListFileHeader ) );
+    blob_ = reinterpret_cast<const C*>( base + sizeof( StrListFileHeader ) + offsetBytes );
+    if( header_.hashBuckets != 0 )
+      buckets_ = reinterpret_cast<const uint32_t*>( base + sizeof( StrListFileHeader ) + offsetBytes +
+                                                    blobBytes + GetStrListFilePadding( blobBytes ) );
+    if( !IsIndexValid() )
+    {
+      Close();
+      return false;
+    }
+    return true;
+  }
+
+  void Close()
+  {
+    file_.Close();
+    header_ = {};
+    offsets_ = nullptr;
+    blob_ = nullptr;
+    buckets_ = nullptr;
+  }
+
+  const_iterator begin() const { return const_iterator( this, 0 ); }
+  const_iterator end() const { return const_iterator( this, size() ); }
+
+  bool empty() const { return size() == 0; }
+  size_type size() const { return static_cast<size_type>( header_.count ); }
+  size_t GetCharCount() const { return static_cast<size_t>( header_.charCount ); }
+  bool HasHashIndex() const { return buckets_ != nullptr; }
+
+  viewT operator[]( size_t index ) const
+  {
+    assert( index < size() );
+    return viewT( blob_ + offsets_[ index ], static_cast<size_t>( offsets_[ index + 1 ] - offsets_[ index ] ) );
+  }
+
+  // Uses the hash index when present, otherwise a linear search
+  bool find( viewT str ) const
+  {
+    if( buckets_ == nullptr )
+      return std::ranges::contains( *this, str );
+
+    auto mask = header_.hashBuckets - 1;
+    for( auto slot = StringUtil::GetHash( str ) & mask; buckets_[ slot ] != 0; slot = ( slot + 1 ) & mask )
+    {
+      if( ( *this )[ buckets_[ slot ] - 1 ] == str )
+        return true;
+    }
+    return false;
+  }
+
+  // Copy into a regular StrListT
+  StrListT<C> GetStrList() const
+  {
+    StrListT<C> strList;
+    for( auto str : *this )
+      strList.push_back( strT( str ) );
+    return strList;
+  }
+
+private:
+
+  // Offsets must run from zero to charCount without decreasing, and every bucket must be empty or
+  // name a string. An index with no empty slot would never end an unsuccessful find().
+  bool IsIndexValid() const
+  {
+    uint64_t prev = 0;
+    for( uint64_t i = 0; i <= header_.count; ++i )
+    {
+      if( offsets_[ i ] < prev || offsets_[ i ] > header_.charCount )
+        return false;
+      prev = offsets_[ i ];
+    }
+    if( prev != header_.charCount )
+      return false;
+
+    if( header_.hashBuckets == 0 )
+      return true;
+    if( !std::has_single_bit( header_.hashBuckets ) )
+      return false;
+    bool hasEmptySlot = false;
+    for( uint64_t slot = 0; slot < header_.hashBuckets; ++slot )
+    {
+      if( buckets_[ slot ] > header_.count )
+        return false;
+      hasEmptySlot |= ( buckets_[ slot ] == 0 );
+    }
+    return hasEmptySlot;
+  }
+
+private:
+
+  MappedFile        file_;
+  StrListFileHeader header_   = {};
+  const uint64_t*   offsets_  = nullptr;
+  const C*          blob_     = nullptr;
+  const uint32_t*   buckets_  = nullptr;
+
+}; // StrListFileT
+
+using StrListFile = StrListFileT<char>;
+using StrListFileW = StrListFileT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
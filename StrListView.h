@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrListView.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Read-only vector of std::string_view with the same interface as StrListT. The views refer
+// either to the strings of an existing StrListT, which must outlive the view, or to a memory
+// mapped file owned by this object.
+
+template< typename C >
+class StrListViewT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+  using List = std::vector< viewT >;
+
+public:
+
+  using value_type      = typename List::value_type;
+  using size_type       = typename List::size_type;
+  using difference_type = typename List::difference_type;
+  using iterator        = typename List::const_iterator;
+  using const_iterator  = typename List::const_iterator;
+  using reference       = const value_type&;
+  using const_reference = const value_type&;
+
+public:
+
+  StrListViewT() = default;
+  StrListViewT( const StrListViewT& ) = delete;
+  StrListViewT( StrListViewT&& ) = default;
+  StrListViewT& operator=( const StrListViewT& ) = delete;
+  StrListViewT& operator=( StrListViewT&& ) = default;
+
+  explicit StrListViewT( const StrListT<C>& strList ) :
+    list_( strList.begin(), strList.end() )
+  {
+  }
+
+  // Map a newline-delimited file and create one view per line. Lines may end in LF or CRLF;
+  // the line terminators are not included. Returns false if the file can't be mapped.
+  bool LoadLines( const std::filesystem::path& path )
+  {
+    list_.clear();
+    if( !file_.Open( path ) )
+      return false;
+
+    viewT text( static_cast<const C*>( file_.GetData() ), file_.GetSize() / sizeof( C ) );
+    if( text.empty() )
+      return true;
+    if( text.back() == C( '\n' ) )
+      text.remove_suffix( 1 );
+
+    // Counting first gives an exact reservation; std::count and the newline search in
+    // StrSplitT are both vectorized by the standard library
+    list_.reserve( static_cast<size_t>( std::count( std::begin( text ), std::end( text ), C( '\n' ) ) ) + 1 );
+    for( auto line : StrUtilT<C>::Split( text, C( '\n' ) ) )
+    {
+      if( !line.empty() && line.back() == C( '\r' ) )
+        line.remove_suffix( 1 );
+      list_.push_back( line );
+    }
+    return true;
+  }
+
+  void clear()
+  {
+    list_.clear();
+    file_.Close();
+  }
+
+  const_iterator begin() const  { return list_.begin(); }
+  const_iterator end() const    { return list_.end(); }
+  const_reference front() const { return list_.front(); }
+
+  bool empty() const     { return list_.empty(); }
+  size_type size() const { return list_.size(); }
+
+  bool find( viewT str ) const
+  {
+    return std::ranges::contains( list_, str );
+  }
+
+  bool ContainsEmptyStrings() const
+  {
+    return std::ranges::any_of( list_, []( const auto& str ) { return str.empty(); } );
+  }
+
+  size_t GetCharCount() const
+  {
+    auto sumStrSizes = []( size_t count, viewT rhs )
+      {
+        return count + rhs.size();
+      };
+    return std::accumulate( begin(), end(), size_t( 0 ), sumStrSizes );
+  }
+
+  // Copy into a regular StrListT
+  StrListT<C> GetStrList() const
+  {
+    StrListT<C> strList;
+    for( auto str : list_ )
+      strList.push_back( strT( str ) );
+    return strList;
+  }
+
+private:
+
+  List       list_;
+  MappedFile file_;
+
+}; // StrListViewT
+
+using StrListView = StrListViewT<char>;
+using StrListViewW = StrListViewT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrPipeline.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "CharUtil.h"
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Stages for Pipeline. Map stages replace one character with another, Filter stages drop
+// characters, Trim stages remove characters from both ends and XmlSafe expands special characters
+// to markup.
+
+namespace Stage
+{
+
+enum class Kind
+{
+  Map,
+  Filter,
+  Trim,
+  Xml
+};
+
+struct Lower
+{
+  static constexpr Kind kKind = Kind::Map;
+  template< typename C > static C Apply( C c ) { return CharUtilT<C>::ToLower( c ); }
+};
+
+struct Upper
+{
+  static constexpr Kind kKind = Kind::Map;
+  template< typename C > static C Apply( C c ) { return CharUtilT<C>::ToUpper( c ); }
+};
+
+// Equivalent to ConvertWildcards::No
+struct GoodFileName
+{
+  static constexpr Kind kKind = Kind::Map;
+  template< typename C > static C Apply( C c ) { return CharUtilT<C>::ToGoodFileChar( c ); }
+};
+
+// Equivalent to ConvertWildcards::Yes
+struct GoodFileNameConvertWildcards
+{
+  static constexpr Kind kKind = Kind::Map;
+  template< typename C > static C Apply( C c ) { return CharUtilT<C>::ToGoodFileCharConvertWildcards( c ); }
+};
+
+// RemoveWildcards followed by GoodFileName is equivalent to ConvertWildcards::Remove
+struct RemoveWildcards
+{
+  static constexpr Kind kKind = Kind::Filter;
+  template< typename C > static bool Keep( C c ) { return !CharUtilT<C>::IsWildcardFileChar( c ); }
+};
+
+// Trims whitespace
+struct Trim
+{
+  static constexpr Kind kKind = Kind::Trim;
+  template< typename C > static bool IsTrimmed( C c ) { return CharUtilT<C>::IsWhitespace( c ); }
+};
+
+// Trims the given characters, e.g. TrimChars<' ', '.'>
+template< auto... Chars >
+struct TrimChars
+{
+  static constexpr Kind kKind = Kind::Trim;
+  template< typename C > static bool IsTrimmed( C c ) { return ( ( c == C( Chars ) ) || ... ); }
+};
+
+// Must be the final stage
+struct XmlSafe
+{
+  static constexpr Kind kKind = Kind::Xml;
+};
+
+} // Stage
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// String transform built at compile time from a list of stages, e.g.
+//
+//    using NormalizeName = Pipeline< Stage::Trim, Stage::Lower, Stage::GoodFileName >;
+//    auto name = NormalizeName::Get( rawName );
+//
+// The result is the same as applying each StrUtilT transform in turn, but without intermediate
+// strings. Map and Filter stages are fused into one function per character, and for characters
+// below 256 its result is cached in a table, so the body of the string costs one lookup per
+// character whatever the number of stages. Trim stages are scheduled first wherever they appear:
+// a character is trimmed by a Trim stage if the earlier stages drop it or map it into the trimmed
+// set, so the ends are located before anything is transformed. The exact output length is then
+// computed from the table and the output allocated once.
+
+template< typename... Stages >
+class Pipeline
+{
+private:
+
+  static constexpr size_t kTrimCount = ( size_t( Stages::kKind == Stage::Kind::Trim ) + ... + 0 );
+  static constexpr size_t kXmlCount = ( size_t( Stages::kKind == Stage::Kind::Xml ) + ... + 0 );
+  static constexpr bool kXmlLast = []()
+    {
+      Stage::Kind kinds[] = { Stage::Kind::Map, Stages::kKind... };
+      return kinds[ sizeof...( Stages ) ] == Stage::Kind::Xml;
+    }();
+
+  static_assert( kTrimCount <= 32, "Pipeline supports at most 32 Trim stages" );
+  static_assert( kXmlCount == 0 || ( kXmlCount == 1 && kXmlLast ), "XmlSafe must be the final Pipeline stage" );
+
+  static constexpr size_t kTableSize = 256;
+
+  // The fused result of the Map, Filter and Trim stages for one input character
+  template< typename C >
+  struct Entry
+  {
+    C        c;         // mapped character
+    uint8_t  length;    // output characters: 0 if dropped, 1, or the length of its XML markup
+    uint32_t trimMask;  // bit k is set if Trim stage k removes this character from the ends
+  };
+
+  template< typename S >
+  using CharOf = std::remove_cvref_t< decltype( std::declval<const S&>()[ 0 ] ) >;
+
+public:
+
+  template< typename S >
+  static auto Get( const S& str )
+  {
+    using C = CharOf<S>;
+    std::basic_string<C> out;
+    Append( out, std::basic_string_view<C>( str ) );
+    return out;
+  }
+
+  template< typename C, typename A >
+  static void Append( std::basic_string<C, std::char_traits<C>, A>& out, std::type_identity_t<std::basic_string_view<C>> str )
+  {
+    str = GetTrimmedView( str );
+
+    size_t length = 0;
+    for( auto c : str )
+      length += Evaluate( c ).length;
+
+    auto size = out.size();
+    out.resize( size + length );
+    C* dest = out.data() + size;
+    for( auto c : str )
+    {
+      auto entry = Evaluate( c );
+      if( entry.length == 1 )
+        *dest++ = entry.c;
+      else if( entry.length > 1 )
+        dest = std::char_traits<C>::copy( dest, StrUtilT<C>::GetXmlCode( entry.c ).data(), entry.length ) + entry.length;
+    }
+  }
+
+private:
+
+  // Apply every Trim stage in order; each sees the characters left by the one before
+  template< typename C >
+  static std::basic_string_view<C> GetTrimmedView( std::basic_string_view<C> str )
+  {
+    size_t start = 0;
+    size_t end = str.size();
+    for( size_t trim = 0; trim < kTrimCount; ++trim )
+    {
+      const uint32_t bit = uint32_t( 1 ) << trim;
+      while( start < end && ( Evaluate( str[ start ] ).trimMask & bit ) )
+        ++start;
+      while( end > start && ( Evaluate( str[ end - 1 ] ).trimMask & bit ) )
+        --end;
+    }
+    return str.substr( start, end - start );
+  }
+
+  template< typename C >
+  static Entry<C> Evaluate( C c )
+  {
+    using U = std::make_unsigned_t<C>;
+    if( static_cast<U>( c ) < kTableSize )
+      return GetTable<C>()[ static_cast<U>( c ) ];
+    return Fuse( c );
+  }
+
+  // Built the first time the pipeline is used with character type C
+  template< typename C >
+  static const std::array<Entry<C>, kTableSize>& GetTable()
+  {
+    static const auto table = []()
+      {
+        std::array<Entry<C>, kTableSize> entries = {};
+        for( size_t i = 0; i < kTableSize; ++i )
+          entries[ i ] = Fuse( static_cast<C>( static_cast<std::make_unsigned_t<C>>( i ) ) );
+        return entries;
+      }();
+    return table;
+  }
+
+  template< typename C >
+  static Entry<C> Fuse( C c )
+  {
+    Entry<C> entry = { c, 1, 0 };
+    uint32_t trim = 0;
+    ( FuseStage<Stages>( entry, trim ), ... );
+    return entry;
+  }
+
+  template< typename S, typename C >
+  static void FuseStage( Entry<C>& entry, uint32_t& trim )
+  {
+    if constexpr( S::kKind == Stage::Kind::Map )
+    {
+      if( entry.length != 0 )
+        entry.c = S::template Apply<C>( entry.c );
+    }
+    else if constexpr( S::kKind == Stage::Kind::Filter )
+    {
+      if( entry.length != 0 && !S::template Keep<C>( entry.c ) )
+        entry.length = 0;
+    }
+    else if constexpr( S::kKind == Stage::Kind::Trim )
+    {
+      // Characters already dropped are invisible to the trim, so can be removed with it
+      if( entry.length == 0 || S::template IsTrimmed<C>( entry.c ) )
+        entry.trimMask |= uint32_t( 1 ) << trim;
+      ++trim;
+    }
+    else if constexpr( S::kKind == Stage::Kind::Xml )
+    {
+      auto code = StrUtilT<C>::GetXmlCode( entry.c );
+      if( entry.length != 0 && !code.empty() )
+        entry.length = static_cast<uint8_t>( code.size() );
+    }
+  }
+
+}; // Pipeline
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrPool.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Thread-safe string interning pool. Each distinct string is stored once, null terminated, in a
+// large arena block; Intern() returns a view of the pooled copy that stays valid for the lifetime
+// of the pool. Two interned views from the same pool are equal exactly when their data pointers
+// are equal.
+
+template< typename C >
+class StrPoolT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+
+  static constexpr size_t kBlockSize = 64 * 1024; // characters
+
+  struct Hash
+  {
+    size_t operator()( viewT str ) const { return static_cast<size_t>( StringUtil::GetHash( str ) ); }
+  };
+
+public:
+
+  StrPoolT() = default;
+  StrPoolT( const StrPoolT& ) = delete;
+  StrPoolT& operator=( const StrPoolT& ) = delete;
+
+  // Returns the pooled copy of str, adding it if needed
+  viewT Intern( viewT str )
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock( mutex_ );
+      auto i = index_.find( str );
+      if( i != index_.end() )
+        return *i;
+    }
+
+    std::unique_lock<std::shared_mutex> lock( mutex_ );
+    auto i = index_.find( str );
+    if( i != index_.end() )
+      return *i;
+    viewT pooled = Allocate( str );
+    index_.insert( pooled );
+    return pooled;
+  }
+
+  // Returns the pooled copy of str, or an empty view with a null data pointer if str has never
+  // been interned
+  viewT Find( viewT str ) const
+  {
+    std::shared_lock<std::shared_mutex> lock( mutex_ );
+    auto i = index_.find( str );
+    return ( i == index_.end() ) ? viewT() : *i;
+  }
+
+  // Number of distinct strings
+  size_t size() const
+  {
+    std::shared_lock<std::shared_mutex> lock( mutex_ );
+    return index_.size();
+  }
+
+  // Bytes of arena storage
+  size_t GetMemoryUsed() const
+  {
+    std::shared_lock<std::shared_mutex> lock( mutex_ );
+    size_t chars = 0;
+    for( const auto& block : blocks_ )
+      chars += block.size;
+    return chars * sizeof( C );
+  }
+
+private:
+
+  struct Block
+  {
+    std::unique_ptr<C[]> chars;
+    size_t size;
+    size_t used;
+  };
+
+  // Copy str into the arena; caller holds the exclusive lock
+  viewT Allocate( viewT str )
+  {
+    size_t needed = str.size() + 1;
+    if( blocks_.empty() || blocks_.back().size - blocks_.back().used < needed )
+    {
+      size_t size = std::max( kBlockSize, needed );
+      blocks_.push_back( { std::make_unique<C[]>( size ), size, 0 } );
+    }
+
+    auto& block = blocks_.back();
+    C* dest = block.chars.get() + block.used;
+    std::char_traits<C>::copy( dest, str.data(), str.size() );
+    dest[ str.size() ] = C( 0 );
+    block.used += needed;
+    return viewT( dest, str.size() );
+  }
+
+private:
+
+  mutable std::shared_mutex            mutex_;
+  std::vector<Block>                   blocks_;
+  std::unordered_set<viewT, Hash>      index_;
+
+}; // StrPoolT
+
+using StrPool = StrPoolT<char>;
+using StrPoolW = StrPoolT<wchar_t>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StrListT whose elements are interned in a shared StrPoolT. Elements are views into the pool,
+// so duplicate strings cost one pointer and length each, and find() and operator== compare
+// pointers rather than characters. The pool must outlive the list.
+
+template< typename C >
+class InternedStrListT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+  using List = std::vector< viewT >;
+
+public:
+
+  using value_type      = typename List::value_type;
+  using size_type       = typename List::size_type;
+  using difference_type = typename List::difference_type;
+  using iterator        = typename List::const_iterator;
+  using const_iterator  = typename List::const_iterator;
+  using reference       = const value_type&;
+  using const_reference = const value_type&;
+
+public:
+
+  explicit InternedStrListT( StrPoolT<C>& pool ) :
+    pool_( &pool )
+  {
+  }
+
+  InternedStrListT( StrPoolT<C>& pool, const StrListT<C>& strList ) :
+    pool_( &pool )
+  {
+    list_.reserve( strList.size() );
+    for( const auto& str : strList )
+      push_back( str );
+  }
+
+  const_iterator begin() const  { return list_.begin(); }
+  const_iterator end() const    { return list_.end(); }
+  const_reference front() const { return list_.front(); }
+
+  bool empty() const     { return list_.empty(); }
+  size_type size() const { return list_.size(); }
+
+  void push_back( viewT str ) { list_.push_back( pool_->Intern( str ) ); }
+  void clear() { list_.clear(); }
+  void reserve( size_type count ) { list_.reserve( count ); }
+
+  // A string that was never interned can't be in the list; otherwise compare pointers only
+  bool find( viewT str ) const
+  {
+    viewT pooled = pool_->Find( str );
+    if( pooled.data() == nullptr )
+      return false;
+    return std::ranges::any_of( list_, [pooled]( viewT i ) { return i.data() == pooled.data(); } );
+  }
+
+  bool ContainsEmptyStrings() const
+  {
+    return std::ranges::any_of( list_, []( viewT str ) { return str.empty(); } );
+  }
+
+  size_t GetCharCount() const
+  {
+    auto sumStrSizes = []( size_t count, viewT rhs )
+      {
+        return count + rhs.size();
+      };
+    return std::accumulate( begin(), end(), size_t( 0 ), sumStrSizes );
+  }
+
+  const StrPoolT<C>& GetPool() const { return *pool_; }
+
+  // Copy into a regular StrListT
+  StrListT<C> GetStrList() const
+  {
+    StrListT<C> strList;
+    strList.reserve( size() );
+    for( auto str : list_ )
+      strList.push_back( strT( str ) );
+    return strList;
+  }
+
+private:
+
+  StrPoolT<C>* pool_;
+  List         list_;
+
+}; // InternedStrListT
+
+// Lists sharing a pool are compared by pointer; otherwise by value
+template< typename C >
+bool operator == ( const InternedStrListT<C>& lhs, const InternedStrListT<C>& rhs )
+{
+  if( lhs.size() != rhs.size() )
+    return false;
+  if( &lhs.GetPool() == &rhs.GetPool() )
+    return std::ranges::equal( lhs, rhs, []( auto i, auto j ) { return i.data() == j.data(); } );
+  return std::ranges::equal( lhs, rhs );
+}
+
+using InternedStrList = InternedStrListT<char>;
+using InternedStrListW = InternedStrListT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
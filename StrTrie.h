@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrTrie.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Immutable radix tree (compressed trie) built in bulk from a StrListT or any range of strings.
+// Nodes are stored breadth first in one vector with each node's children adjacent, and the first
+// character of every edge is kept in a parallel array, so choosing a child scans a few contiguous
+// characters. Supports exact, prefix and longest-prefix queries, e.g. matching paths to rules.
+
+template< typename C >
+class StrTrieT
+{
+private:
+
+  using strT = std::basic_string< C >;
+  using viewT = std::basic_string_view< C >;
+
+  struct Node
+  {
+    uint32_t labelOffset;   // edge label from parent, in labels_
+    uint32_t labelLength;
+    uint32_t firstChild;    // children are nodes_[ firstChild, firstChild + childCount )
+    uint32_t childCount;
+    bool     isKey;         // a key ends at this node
+  };
+
+public:
+
+  static constexpr size_t npos = size_t( -1 );
+
+  StrTrieT()
+  {
+    Build( {} );
+  }
+
+  template< std::ranges::input_range R >
+  explicit StrTrieT( const R& strs )
+  {
+    std::vector<viewT> keys;
+    for( const auto& str : strs )
+      keys.push_back( viewT( str ) );
+    Build( std::move( keys ) );
+  }
+
+  // Number of distinct keys
+  size_t size() const { return keyCount_; }
+  bool empty() const { return keyCount_ == 0; }
+
+  bool find( viewT str ) const
+  {
+    bool found = false;
+    Walk( str, [&found, &str]( size_t length ) { found = ( length == str.size() ); } );
+    return found;
+  }
+
+  // Length of the longest key that is a prefix of str, or npos if none is
+  size_t GetLongestPrefix( viewT str ) const
+  {
+    size_t longest = npos;
+    Walk( str, [&longest]( size_t length ) { longest = length; } );
+    return longest;
+  }
+
+  // Every key that is a prefix of str, shortest first, as views into str
+  std::vector<viewT> GetAllPrefixes( viewT str ) const
+  {
+    std::vector<viewT> prefixes;
+    Walk( str, [&prefixes, &str]( size_t length ) { prefixes.push_back( str.substr( 0, length ) ); } );
+    return prefixes;
+  }
+
+  // True if any key starts with prefix
+  bool StartsWith( viewT prefix ) const
+  {
+    uint32_t node = 0;
+    size_t pos = 0;
+    while( pos < prefix.size() )
+    {
+      auto child = FindChild( node, prefix[ pos ] );
+      if( child == 0 )
+        return false;
+      auto label = GetLabel( child );
+      auto remaining = prefix.substr( pos );
+      if( remaining.size() <= label.size() )
+        return label.starts_with( remaining );
+      if( !remaining.starts_with( label ) )
+        return false;
+      pos += label.size();
+      node = child;
+    }
+    return !empty();
+  }
+
+  // Bytes used by nodes and labels
+  size_t GetMemoryUsed() const
+  {
+    return ( nodes_.size() * sizeof( Node ) ) + ( firstChars_.size() + labels_.size() ) * sizeof( C );
+  }
+
+private:
+
+  void Build( std::vector<viewT> keys )
+  {
+    std::ranges::sort( keys );
+    auto [dupBeg, dupEnd] = std::ranges::unique( keys );
+    keys.erase( dupBeg, dupEnd );
+    keyCount_ = keys.size();
+
+    struct Pending
+    {
+      uint32_t node;
+      size_t   lo;      // keys[ lo, hi ) pass through node
+      size_t   hi;
+      size_t   depth;   // characters matched at node
+    };
+
+    nodes_.push_back( { 0, 0, 0, 0, false } );
+    firstChars_.push_back( C( 0 ) );
+    std::deque<Pending> queue{ { 0, 0, keys.size(), 0 } };
+    while( !queue.empty() )
+    {
+      auto [node, lo, hi, depth] = queue.front();
+      queue.pop_front();
+
+      // Sorted order puts a key that ends here ahead of any longer key
+      if( lo < hi && keys[ lo ].size() == depth )
+      {
+        nodes_[ node ].isKey = true;
+        ++lo;
+      }
+
+      nodes_[ node ].firstChild = static_cast<uint32_t>( nodes_.size() );
+      while( lo < hi )
+      {
+        // Group keys sharing the next character; the group's common prefix is the common
+        // prefix of its first and last keys
+        auto next = keys[ lo ][ depth ];
+        auto groupEnd = lo + 1;
+        while( groupEnd < hi && keys[ groupEnd ][ depth ] == next )
+          ++groupEnd;
+        auto first = keys[ lo ];
+        auto last = keys[ groupEnd - 1 ];
+        auto [firstMismatch, lastMismatch] = std::mismatch( first.begin() + static_cast<ptrdiff_t>( depth ),
+                                                            first.end(), last.begin() + static_cast<ptrdiff_t>( depth ), last.end() );
+        auto commonLength = static_cast<size_t>( firstMismatch - first.begin() );
+
+        auto child = static_cast<uint32_t>( nodes_.size() );
+        nodes_.push_back( { static_cast<uint32_t>( labels_.size() ), static_cast<uint32_t>( commonLength - depth ), 0, 0, false } );
+        firstChars_.push_back( next );
+        labels_.append( first.substr( depth, commonLength - depth ) );
+        ++nodes_[ node ].childCount;
+        queue.push_back( { child, lo, groupEnd, commonLength } );
+        lo = groupEnd;
+      }
+    }
+  }
+
+  viewT GetLabel( uint32_t node ) const
+  {
+    return viewT( labels_ ).substr( nodes_[ node ].labelOffset, nodes_[ node ].labelLength );
+  }
+
+  // Returns the child of node whose label starts with c, or zero
+  uint32_t FindChild( uint32_t node, C c ) const
+  {
+    auto first = nodes_[ node ].firstChild;
+    auto last = first + nodes_[ node ].childCount;
+    for( auto child = first; child < last; ++child )
+      if( firstChars_[ child ] == c )
+        return child;
+    return 0;
+  }
+
+  // Calls fn( length ) for each key that is a prefix of str, shortest first
+  template< typename Fn >
+  void Walk( viewT str, Fn fn ) const
+  {
+    uint32_t node = 0;
+    size_t pos = 0;
+    for( ;; )
+    {
+      if( nodes_[ node ].isKey )
+        fn( pos );
+      if( pos == str.size() )
+        return;
+      auto child = FindChild( node, str[ pos ] );
+      if( child == 0 || !str.substr( pos ).starts_with( GetLabel( child ) ) )
+        return;
+      pos += nodes_[ child ].labelLength;
+      node = child;
+    }
+  }
+
+private:
+
+  std::vector<Node> nodes_;       // nodes_[ 0 ] is the root
+  std::vector<C>    firstChars_;  // first character of each node's label
+  strT              labels_;
+  size_t            keyCount_ = 0;
+
+}; // StrTrieT
+
+using StrTrie = StrTrieT<char>;
+using StrTrieW = StrTrieT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -16,13 +16,32 @@
 #include <cassert>
 #include <array>
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+#if defined( __SSSE3__ ) || defined( __AVX__ )
+#include <tmmintrin.h>
+#endif
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
 #include "CharUtil.h"
 #include "Util.h"
 
@@ -50,96 +69,1660 @@ constexpr std::array<XmlMarkup, 5> kXmlReplace =
 namespace PKIsensee
 {
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Conversions
+
+namespace StringUtil {
+
+template<typename T, typename F>
+inline T TransformTo( F str ) noexcept
+{
+  return { std::begin( str ), std::end( str ) };
+}
+
+#pragma warning(push)
+#pragma warning(disable: 4244) // ignore loss of data; it's expected
+
+inline std::string GetUtf8( std::wstring_view wstr )
+{
+  return TransformTo<std::string>( wstr );
+}
+#pragma warning(pop)
+
+inline std::wstring GetUtf16( std::string_view str )
+{
+  return TransformTo<std::wstring>( str );
+}
+
+// FNV-1a hash of each character of str. Pass a previous result as the seed to hash
+// discontiguous data incrementally.
+
+constexpr uint64_t kHashSeed = 0xCBF29CE484222325ull;
+
+template< typename C >
+constexpr uint64_t GetHash( std::basic_string_view<C> str, uint64_t seed = kHashSeed ) noexcept
+{
+  constexpr uint64_t kPrime = 0x00000100000001B3ull;
+  uint64_t hash = seed;
+  for( auto c : str )
+  {
+    hash ^= static_cast<std::make_unsigned_t<C>>( c );
+    hash *= kPrime;
+  }
+  return hash;
+}
+
+// Scramble all bits of a hash (splitmix64 finalizer); FNV-1a alone has weak low bits
+constexpr uint64_t MixHash( uint64_t hash ) noexcept
+{
+  hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+  hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBull;
+  return hash ^ ( hash >> 31 );
+}
+
+// Tables and vector kernels behind the Base64 and hex functions below
+namespace Detail
+{
+
+// Binary-to-text alphabets
+constexpr char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kBase64UrlChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char kHexChars[] = "0123456789abcdef";
+
+// Decoding tables map each character to its value, or to kInvalid or kSpace
+constexpr int8_t kInvalid = -1;
+constexpr int8_t kSpace = -2;
+
+constexpr std::array<int8_t, 256> MakeDecodeTable( std::string_view chars, std::string_view altChars = {} )
+{
+  std::array<int8_t, 256> table = {};
+  table.fill( kInvalid );
+  for( auto c : std::string_view( " \t\r\n" ) )
+    table[ static_cast<uint8_t>( c ) ] = kSpace;
+  for( size_t i = 0; i < chars.size(); ++i )
+    table[ static_cast<uint8_t>( chars[ i ] ) ] = static_cast<int8_t>( i );
+  for( size_t i = 0; i < altChars.size(); ++i )
+    table[ static_cast<uint8_t>( altChars[ i ] ) ] = static_cast<int8_t>( i );
+  return table;
+}
+
+constexpr auto kBase64Decode = MakeDecodeTable( kBase64Chars );
+constexpr auto kBase64UrlDecode = MakeDecodeTable( kBase64UrlChars );
+constexpr auto kBase64AnyDecode = MakeDecodeTable( kBase64Chars, kBase64UrlChars );
+constexpr auto kHexDecode = MakeDecodeTable( kHexChars, "0123456789ABCDEF" );
+
+// Vector Base64 and hex kernels. Each handles whole blocks from the start of its input and returns
+// the input consumed, leaving the remainder, whitespace, padding and errors to the scalar code.
+
+// The characters for sextets 62 and 63; lenient decoding accepts those of both alphabets
+struct Base64Symbols
+{
+  char plus;
+  char slash;
+  char altPlus;
+  char altSlash;
+};
+
+#if defined( __AVX2__ )
+
+// 24 bytes, as 12 in each lane, to 32 sextets, one per byte
+inline __m256i GetBase64Sextets( __m256i in ) noexcept
+{
+  in = _mm256_shuffle_epi8( in, _mm256_setr_epi8( 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                  1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 ) );
+  auto high = _mm256_mulhi_epu16( _mm256_and_si256( in, _mm256_set1_epi32( 0x0FC0FC00 ) ), _mm256_set1_epi32( 0x04000040 ) );
+  auto low = _mm256_mullo_epi16( _mm256_and_si256( in, _mm256_set1_epi32( 0x003F03F0 ) ), _mm256_set1_epi32( 0x01000010 ) );
+  return _mm256_or_si256( high, low );
+}
+
+// Sextets to characters by adding the offset for each range of the alphabet
+inline __m256i GetBase64Chars( __m256i sextets, Base64Symbols symbols ) noexcept
+{
+  auto above = [sextets]( char value, int offset )
+    {
+      return _mm256_and_si256( _mm256_cmpgt_epi8( sextets, _mm256_set1_epi8( value ) ), _mm256_set1_epi8( static_cast<char>( offset ) ) );
+    };
+  auto offset = _mm256_set1_epi8( 'A' );
+  offset = _mm256_add_epi8( offset, above( 25, ( 'a' - 26 ) - 'A' ) );
+  offset = _mm256_add_epi8( offset, above( 51, ( '0' - 52 ) - ( 'a' - 26 ) ) );
+  offset = _mm256_add_epi8( offset, above( 61, ( symbols.plus - 62 ) - ( '0' - 52 ) ) );
+  offset = _mm256_add_epi8( offset, above( 62, ( symbols.slash - 63 ) - ( symbols.plus - 62 ) ) );
+  return _mm256_add_epi8( sextets, offset );
+}
+
+// Characters to sextets; valid is set for the characters in the alphabet
+inline __m256i GetBase64Values( __m256i chars, Base64Symbols symbols, __m256i& valid ) noexcept
+{
+  auto inRange = [chars]( char lo, char hi )
+    {
+      return _mm256_and_si256( _mm256_cmpgt_epi8( chars, _mm256_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                               _mm256_cmpgt_epi8( _mm256_set1_epi8( static_cast<char>( hi + 1 ) ), chars ) );
+    };
+  auto isAny = [chars]( char c, char alt )
+    {
+      return _mm256_or_si256( _mm256_cmpeq_epi8( chars, _mm256_set1_epi8( c ) ), _mm256_cmpeq_epi8( chars, _mm256_set1_epi8( alt ) ) );
+    };
+  auto upper = inRange( 'A', 'Z' );
+  auto lower = inRange( 'a', 'z' );
+  auto digit = inRange( '0', '9' );
+  auto plus = isAny( symbols.plus, symbols.altPlus );
+  auto slash = isAny( symbols.slash, symbols.altSlash );
+  valid = _mm256_or_si256( _mm256_or_si256( _mm256_or_si256( upper, lower ), _mm256_or_si256( digit, plus ) ), slash );
+
+  auto offset = _mm256_or_si256( _mm256_and_si256( upper, _mm256_set1_epi8( -'A' ) ),
+                _mm256_or_si256( _mm256_and_si256( lower, _mm256_set1_epi8( 26 - 'a' ) ),
+                                 _mm256_and_si256( digit, _mm256_set1_epi8( 52 - '0' ) ) ) );
+  auto letters = _mm256_and_si256( _mm256_or_si256( upper, _mm256_or_si256( lower, digit ) ), _mm256_add_epi8( chars, offset ) );
+  return _mm256_or_si256( letters, _mm256_or_si256( _mm256_and_si256( plus, _mm256_set1_epi8( 62 ) ),
+                                                    _mm256_and_si256( slash, _mm256_set1_epi8( 63 ) ) ) );
+}
+
+// 32 sextets to 24 bytes in the low 24 bytes of the result
+inline __m256i PackBase64Values( __m256i values ) noexcept
+{
+  auto pairs = _mm256_maddubs_epi16( values, _mm256_set1_epi32( 0x01400140 ) );
+  auto quads = _mm256_madd_epi16( pairs, _mm256_set1_epi32( 0x00011000 ) );
+  auto lanes = _mm256_shuffle_epi8( quads, _mm256_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                             2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+  return _mm256_permutevar8x32_epi32( lanes, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+}
+
+// Nibbles to lowercase hex digits
+inline __m256i GetHexChars( __m256i nibbles ) noexcept
+{
+  auto letters = _mm256_and_si256( _mm256_cmpgt_epi8( nibbles, _mm256_set1_epi8( 9 ) ), _mm256_set1_epi8( 'a' - '0' - 10 ) );
+  return _mm256_add_epi8( _mm256_add_epi8( nibbles, _mm256_set1_epi8( '0' ) ), letters );
+}
+
+// Hex digits of either case to nibbles; valid is set for the hex digits
+inline __m256i GetHexValues( __m256i chars, __m256i& valid ) noexcept
+{
+  auto inRange = [chars]( char lo, char hi )
+    {
+      return _mm256_and_si256( _mm256_cmpgt_epi8( chars, _mm256_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                               _mm256_cmpgt_epi8( _mm256_set1_epi8( static_cast<char>( hi + 1 ) ), chars ) );
+    };
+  auto digit = inRange( '0', '9' );
+  auto lower = inRange( 'a', 'f' );
+  auto upper = inRange( 'A', 'F' );
+  valid = _mm256_or_si256( digit, _mm256_or_si256( lower, upper ) );
+  auto offset = _mm256_or_si256( _mm256_and_si256( digit, _mm256_set1_epi8( -'0' ) ),
+                _mm256_or_si256( _mm256_and_si256( lower, _mm256_set1_epi8( 10 - 'a' ) ),
+                                 _mm256_and_si256( upper, _mm256_set1_epi8( 10 - 'A' ) ) ) );
+  return _mm256_add_epi8( chars, offset );
+}
+
+// Pairs of nibbles, high first, to bytes in the low half of each 16-bit lane
+inline __m256i PackHexValues( __m256i values ) noexcept
+{
+  return _mm256_or_si256( _mm256_slli_epi16( _mm256_and_si256( values, _mm256_set1_epi16( 0x00FF ) ), 4 ),
+                          _mm256_srli_epi16( values, 8 ) );
+}
+
+#endif // __AVX2__
+
+#if defined( __SSSE3__ ) || defined( __AVX__ )
+
+// 12 bytes to 16 sextets, one per byte
+inline __m128i GetBase64Sextets( __m128i in ) noexcept
+{
+  in = _mm_shuffle_epi8( in, _mm_setr_epi8( 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 ) );
+  auto high = _mm_mulhi_epu16( _mm_and_si128( in, _mm_set1_epi32( 0x0FC0FC00 ) ), _mm_set1_epi32( 0x04000040 ) );
+  auto low = _mm_mullo_epi16( _mm_and_si128( in, _mm_set1_epi32( 0x003F03F0 ) ), _mm_set1_epi32( 0x01000010 ) );
+  return _mm_or_si128( high, low );
+}
+
+inline __m128i GetBase64Chars( __m128i sextets, Base64Symbols symbols ) noexcept
+{
+  auto above = [sextets]( char value, int offset )
+    {
+      return _mm_and_si128( _mm_cmpgt_epi8( sextets, _mm_set1_epi8( value ) ), _mm_set1_epi8( static_cast<char>( offset ) ) );
+    };
+  auto offset = _mm_set1_epi8( 'A' );
+  offset = _mm_add_epi8( offset, above( 25, ( 'a' - 26 ) - 'A' ) );
+  offset = _mm_add_epi8( offset, above( 51, ( '0' - 52 ) - ( 'a' - 26 ) ) );
+  offset = _mm_add_epi8( offset, above( 61, ( symbols.plus - 62 ) - ( '0' - 52 ) ) );
+  offset = _mm_add_epi8( offset, above( 62, ( symbols.slash - 63 ) - ( symbols.plus - 62 ) ) );
+  return _mm_add_epi8( sextets, offset );
+}
+
+inline __m128i GetBase64Values( __m128i chars, Base64Symbols symbols, __m128i& valid ) noexcept
+{
+  auto inRange = [chars]( char lo, char hi )
+    {
+      return _mm_and_si128( _mm_cmpgt_epi8( chars, _mm_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                            _mm_cmplt_epi8( chars, _mm_set1_epi8( static_cast<char>( hi + 1 ) ) ) );
+    };
+  auto isAny = [chars]( char c, char alt )
+    {
+      return _mm_or_si128( _mm_cmpeq_epi8( chars, _mm_set1_epi8( c ) ), _mm_cmpeq_epi8( chars, _mm_set1_epi8( alt ) ) );
+    };
+  auto upper = inRange( 'A', 'Z' );
+  auto lower = inRange( 'a', 'z' );
+  auto digit = inRange( '0', '9' );
+  auto plus = isAny( symbols.plus, symbols.altPlus );
+  auto slash = isAny( symbols.slash, symbols.altSlash );
+  valid = _mm_or_si128( _mm_or_si128( _mm_or_si128( upper, lower ), _mm_or_si128( digit, plus ) ), slash );
+
+  auto offset = _mm_or_si128( _mm_and_si128( upper, _mm_set1_epi8( -'A' ) ),
+                _mm_or_si128( _mm_and_si128( lower, _mm_set1_epi8( 26 - 'a' ) ),
+                              _mm_and_si128( digit, _mm_set1_epi8( 52 - '0' ) ) ) );
+  auto letters = _mm_and_si128( _mm_or_si128( upper, _mm_or_si128( lower, digit ) ), _mm_add_epi8( chars, offset ) );
+  return _mm_or_si128( letters, _mm_or_si128( _mm_and_si128( plus, _mm_set1_epi8( 62 ) ),
+                                              _mm_and_si128( slash, _mm_set1_epi8( 63 ) ) ) );
+}
+
+// 16 sextets to 12 bytes in the low 12 bytes of the result
+inline __m128i PackBase64Values( __m128i values ) noexcept
+{
+  auto pairs = _mm_maddubs_epi16( values, _mm_set1_epi32( 0x01400140 ) );
+  auto quads = _mm_madd_epi16( pairs, _mm_set1_epi32( 0x00011000 ) );
+  return _mm_shuffle_epi8( quads, _mm_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+}
+
+#endif // __SSSE3__
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+
+inline __m128i GetHexChars( __m128i nibbles ) noexcept
+{
+  auto letters = _mm_and_si128( _mm_cmpgt_epi8( nibbles, _mm_set1_epi8( 9 ) ), _mm_set1_epi8( 'a' - '0' - 10 ) );
+  return _mm_add_epi8( _mm_add_epi8( nibbles, _mm_set1_epi8( '0' ) ), letters );
+}
+
+inline __m128i GetHexValues( __m128i chars, __m128i& valid ) noexcept
+{
+  auto inRange = [chars]( char lo, char hi )
+    {
+      return _mm_and_si128( _mm_cmpgt_epi8( chars, _mm_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                            _mm_cmplt_epi8( chars, _mm_set1_epi8( static_cast<char>( hi + 1 ) ) ) );
+    };
+  auto digit = inRange( '0', '9' );
+  auto lower = inRange( 'a', 'f' );
+  auto upper = inRange( 'A', 'F' );
+  valid = _mm_or_si128( digit, _mm_or_si128( lower, upper ) );
+  auto offset = _mm_or_si128( _mm_and_si128( digit, _mm_set1_epi8( -'0' ) ),
+                _mm_or_si128( _mm_and_si128( lower, _mm_set1_epi8( 10 - 'a' ) ),
+                              _mm_and_si128( upper, _mm_set1_epi8( 10 - 'A' ) ) ) );
+  return _mm_add_epi8( chars, offset );
+}
+
+inline __m128i PackHexValues( __m128i values ) noexcept
+{
+  return _mm_or_si128( _mm_slli_epi16( _mm_and_si128( values, _mm_set1_epi16( 0x00FF ) ), 4 ), _mm_srli_epi16( values, 8 ) );
+}
+
+#endif // __SSE2__
+
+#if defined( __SSSE3__ ) || defined( __AVX__ )
+
+// Encode whole blocks of bytes from the start of in; returns the bytes consumed, a multiple of
+// three, having written four characters for every three bytes
+inline size_t EncodeBase64Blocks( std::span<const uint8_t> in, char* out, Base64Symbols symbols ) noexcept
+{
+  size_t i = 0;
+#if defined( __AVX2__ )
+  // Each lane loads 16 bytes and uses 12
+  for( ; i + 28 <= in.size(); i += 24, out += 32 )
+  {
+    auto low = _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i ) );
+    auto high = _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i + 12 ) );
+    auto bytes = _mm256_inserti128_si256( _mm256_castsi128_si256( low ), high, 1 );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), GetBase64Chars( GetBase64Sextets( bytes ), symbols ) );
+  }
+#endif
+  for( ; i + 16 <= in.size(); i += 12, out += 16 )
+  {
+    auto bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out ), GetBase64Chars( GetBase64Sextets( bytes ), symbols ) );
+  }
+  return i;
+}
+
+// Decode whole blocks of alphabet characters from the start of in, stopping at the first block
+// containing anything else; returns the characters consumed, a multiple of four, having written
+// three bytes for every four characters. Writes up to 8 bytes past the decoded data, so stops
+// short of capacity.
+inline size_t DecodeBase64Blocks( std::string_view in, uint8_t* out, size_t capacity, Base64Symbols symbols ) noexcept
+{
+  size_t i = 0;
+  size_t written = 0;
+#if defined( __AVX2__ )
+  for( ; i + 32 <= in.size() && written + 32 <= capacity; i += 32, written += 24 )
+  {
+    __m256i valid;
+    auto values = GetBase64Values( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( in.data() + i ) ), symbols, valid );
+    if( _mm256_movemask_epi8( valid ) != -1 )
+      return i;
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + written ), PackBase64Values( values ) );
+  }
+#endif
+  for( ; i + 16 <= in.size() && written + 16 <= capacity; i += 16, written += 12 )
+  {
+    __m128i valid;
+    auto values = GetBase64Values( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i ) ), symbols, valid );
+    if( _mm_movemask_epi8( valid ) != 0xFFFF )
+      return i;
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out + written ), PackBase64Values( values ) );
+  }
+  return i;
+}
+
+#endif // __SSSE3__
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+
+// Encode whole blocks of bytes as lowercase hex; returns the bytes consumed
+inline size_t EncodeHexBlocks( std::span<const uint8_t> in, char* out ) noexcept
+{
+  size_t i = 0;
+#if defined( __AVX2__ )
+  for( ; i + 32 <= in.size(); i += 32, out += 64 )
+  {
+    auto bytes = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( in.data() + i ) );
+    auto high = GetHexChars( _mm256_and_si256( _mm256_srli_epi16( bytes, 4 ), _mm256_set1_epi8( 0x0F ) ) );
+    auto low = GetHexChars( _mm256_and_si256( bytes, _mm256_set1_epi8( 0x0F ) ) );
+    auto first = _mm256_unpacklo_epi8( high, low );   // bytes 0-7 and 16-23
+    auto second = _mm256_unpackhi_epi8( high, low );  // bytes 8-15 and 24-31
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), _mm256_permute2x128_si256( first, second, 0x20 ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + 32 ), _mm256_permute2x128_si256( first, second, 0x31 ) );
+  }
+#endif
+  for( ; i + 16 <= in.size(); i += 16, out += 32 )
+  {
+    auto bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i ) );
+    auto high = GetHexChars( _mm_and_si128( _mm_srli_epi16( bytes, 4 ), _mm_set1_epi8( 0x0F ) ) );
+    auto low = GetHexChars( _mm_and_si128( bytes, _mm_set1_epi8( 0x0F ) ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out ), _mm_unpacklo_epi8( high, low ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out + 16 ), _mm_unpackhi_epi8( high, low ) );
+  }
+  return i;
+}
+
+// Decode whole blocks of hex digits, stopping at the first block containing anything else;
+// returns the characters consumed, always even
+inline size_t DecodeHexBlocks( std::string_view in, uint8_t* out, size_t capacity ) noexcept
+{
+  size_t i = 0;
+  size_t written = 0;
+#if defined( __AVX2__ )
+  for( ; i + 64 <= in.size() && written + 32 <= capacity; i += 64, written += 32 )
+  {
+    __m256i valid0;
+    __m256i valid1;
+    auto values0 = GetHexValues( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( in.data() + i ) ), valid0 );
+    auto values1 = GetHexValues( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( in.data() + i + 32 ) ), valid1 );
+    if( _mm256_movemask_epi8( _mm256_and_si256( valid0, valid1 ) ) != -1 )
+      return i;
+    auto bytes = _mm256_packus_epi16( PackHexValues( values0 ), PackHexValues( values1 ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + written ), _mm256_permute4x64_epi64( bytes, 0xD8 ) );
+  }
+#endif
+  for( ; i + 32 <= in.size() && written + 16 <= capacity; i += 32, written += 16 )
+  {
+    __m128i valid0;
+    __m128i valid1;
+    auto values0 = GetHexValues( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i ) ), valid0 );
+    auto values1 = GetHexValues( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in.data() + i + 16 ) ), valid1 );
+    if( _mm_movemask_epi8( _mm_and_si128( valid0, valid1 ) ) != 0xFFFF )
+      return i;
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out + written ), _mm_packus_epi16( PackHexValues( values0 ), PackHexValues( values1 ) ) );
+  }
+  return i;
+}
+
+#endif // __SSE2__
+
+} // Detail
+
+// Base64 (RFC 4648) and hex encoding of binary data. Standard Base64 is padded with '='; the
+// URL-safe alphabet replaces + and / with - and _ and is encoded unpadded. Strict decoding accepts
+// only canonical input in the given alphabet. Lenient decoding skips whitespace, accepts either
+// Base64 alphabet, and ignores missing padding and nonzero trailing bits. Decoding functions write
+// to a caller buffer whose capacity is passed in size, which is updated to the bytes written; they
+// return false on malformed input or insufficient space. Bulk data goes through AVX2 or SSSE3
+// kernels for Base64 and AVX2 or SSE2 kernels for hex where the target supports them.
+
+enum class Base64Alphabet
+{
+  Standard,
+  UrlSafe
+};
+
+enum class DecodeMode
+{
+  Strict,
+  Lenient
+};
+
+constexpr size_t GetBase64Length( size_t byteCount, Base64Alphabet alphabet = Base64Alphabet::Standard ) noexcept
+{
+  return ( alphabet == Base64Alphabet::Standard ) ? ( ( byteCount + 2 ) / 3 ) * 4 : ( ( byteCount * 4 ) + 2 ) / 3;
+}
+
+// Upper bound on the bytes decoded from charCount characters
+constexpr size_t GetBase64DecodedMaxLength( size_t charCount ) noexcept
+{
+  return ( ( charCount + 3 ) / 4 ) * 3;
+}
+
+// Returns the characters written, which is always GetBase64Length()
+inline size_t Base64Encode( std::span<const uint8_t> bytes, char* out, Base64Alphabet alphabet = Base64Alphabet::Standard ) noexcept
+{
+  const char* chars = ( alphabet == Base64Alphabet::Standard ) ? Detail::kBase64Chars : Detail::kBase64UrlChars;
+  char* start = out;
+  size_t i = 0;
+#if defined( __SSSE3__ ) || defined( __AVX__ )
+  i = Detail::EncodeBase64Blocks( bytes, out, { chars[ 62 ], chars[ 63 ], chars[ 62 ], chars[ 63 ] } );
+  out += ( i / 3 ) * 4;
+#endif
+
+  // Three bytes become four characters; the loop body has no branches
+  for( ; i + 3 <= bytes.size(); i += 3 )
+  {
+    uint32_t triple = ( uint32_t( bytes[ i ] ) << 16 ) | ( uint32_t( bytes[ i + 1 ] ) << 8 ) | bytes[ i + 2 ];
+    out[ 0 ] = chars[ ( triple >> 18 ) & 0x3F ];
+    out[ 1 ] = chars[ ( triple >> 12 ) & 0x3F ];
+    out[ 2 ] = chars[ ( triple >> 6 ) & 0x3F ];
+    out[ 3 ] = chars[ triple & 0x3F ];
+    out += 4;
+  }
+
+  auto remaining = bytes.size() - i;
+  if( remaining != 0 )
+  {
+    uint32_t triple = uint32_t( bytes[ i ] ) << 16;
+    if( remaining == 2 )
+      triple |= uint32_t( bytes[ i + 1 ] ) << 8;
+    *out++ = chars[ ( triple >> 18 ) & 0x3F ];
+    *out++ = chars[ ( triple >> 12 ) & 0x3F ];
+    if( remaining == 2 )
+      *out++ = chars[ ( triple >> 6 ) & 0x3F ];
+    if( alphabet == Base64Alphabet::Standard )
+    {
+      *out++ = '=';
+      if( remaining == 1 )
+        *out++ = '=';
+    }
+  }
+  return static_cast<size_t>( out - start );
+}
+
+inline void AppendBase64( std::string& out, std::span<const uint8_t> bytes, Base64Alphabet alphabet = Base64Alphabet::Standard )
+{
+  auto size = out.size();
+  out.resize( size + GetBase64Length( bytes.size(), alphabet ) );
+  Base64Encode( bytes, out.data() + size, alphabet );
+}
+
+inline std::string GetBase64( std::span<const uint8_t> bytes, Base64Alphabet alphabet = Base64Alphabet::Standard )
+{
+  std::string base64;
+  AppendBase64( base64, bytes, alphabet );
+  return base64;
+}
+
+inline bool Base64Decode( std::string_view str, uint8_t* out, size_t& size,
+                          Base64Alphabet alphabet = Base64Alphabet::Standard, DecodeMode mode = DecodeMode::Strict ) noexcept
+{
+  const auto& table = ( mode == DecodeMode::Lenient ) ? Detail::kBase64AnyDecode :
+                      ( alphabet == Base64Alphabet::Standard ) ? Detail::kBase64Decode : Detail::kBase64UrlDecode;
+  const size_t capacity = size;
+  size = 0;
+  size_t pos = 0;
+  size_t charCount = 0;
+
+  // Fast path: whole groups of four valid characters, vectorized where possible
+  auto decodeGroups = [&]()
+    {
+      auto start = pos;
+#if defined( __SSSE3__ ) || defined( __AVX__ )
+      using Detail::Base64Symbols;
+      const Base64Symbols symbols = ( mode == DecodeMode::Lenient ) ? Base64Symbols{ '+', '/', '-', '_' } :
+                                    ( alphabet == Base64Alphabet::Standard ) ? Base64Symbols{ '+', '/', '+', '/' } :
+                                                                               Base64Symbols{ '-', '_', '-', '_' };
+      auto consumed = Detail::DecodeBase64Blocks( str.substr( pos ), out + size, capacity - size, symbols );
+      pos += consumed;
+      size += ( consumed / 4 ) * 3;
+#endif
+      for( ; pos + 4 <= str.size() && size + 3 <= capacity; pos += 4 )
+      {
+        auto a = table[ static_cast<uint8_t>( str[ pos ] ) ];
+        auto b = table[ static_cast<uint8_t>( str[ pos + 1 ] ) ];
+        auto c = table[ static_cast<uint8_t>( str[ pos + 2 ] ) ];
+        auto d = table[ static_cast<uint8_t>( str[ pos + 3 ] ) ];
+        if( ( a | b | c | d ) < 0 )
+          break;
+        uint32_t quad = ( uint32_t( a ) << 18 ) | ( uint32_t( b ) << 12 ) | ( uint32_t( c ) << 6 ) | uint32_t( d );
+        out[ size ] = static_cast<uint8_t>( quad >> 16 );
+        out[ size + 1 ] = static_cast<uint8_t>( quad >> 8 );
+        out[ size + 2 ] = static_cast<uint8_t>( quad );
+        size += 3;
+      }
+      charCount += pos - start;
+    };
+  decodeGroups();
+
+  // Remainder, padding, whitespace and errors, one character at a time; whitespace between
+  // groups, such as line breaks, returns to the fast path
+  uint32_t accum = 0;
+  size_t sextets = 0;
+  size_t padding = 0;
+  while( pos < str.size() )
+  {
+    auto c = str[ pos++ ];
+    auto value = table[ static_cast<uint8_t>( c ) ];
+    if( value == Detail::kSpace && mode == DecodeMode::Lenient )
+    {
+      if( sextets == 0 && padding == 0 )
+        decodeGroups();
+      continue;
+    }
+    ++charCount;
+    if( c == '=' )
+    {
+      ++padding;
+      continue;
+    }
+    if( value < 0 || padding != 0 )
+      return false;
+    accum = ( accum << 6 ) | uint32_t( value );
+    if( ++sextets == 4 )
+    {
+      if( size + 3 > capacity )
+        return false;
+      out[ size++ ] = static_cast<uint8_t>( accum >> 16 );
+      out[ size++ ] = static_cast<uint8_t>( accum >> 8 );
+      out[ size++ ] = static_cast<uint8_t>( accum );
+      accum = 0;
+      sextets = 0;
+    }
+  }
+
+  // Two or three trailing characters encode one or two bytes
+  const size_t kTailBytes[] = { 0, 0, 1, 2 };
+  if( sextets == 1 || padding > 2 || ( padding != 0 && sextets == 0 ) )
+    return false;
+  auto tailBytes = kTailBytes[ sextets ];
+  uint32_t unusedBits = accum & ( ( sextets == 2 ) ? 0xF : 0x3 );
+  if( mode == DecodeMode::Strict && sextets != 0 )
+  {
+    // Padding is required for Standard and optional for UrlSafe, but must be complete if present
+    bool isPaddingOk = ( charCount % 4 == 0 ) || ( alphabet == Base64Alphabet::UrlSafe && padding == 0 );
+    if( !isPaddingOk || unusedBits != 0 )
+      return false;
+  }
+  if( size + tailBytes > capacity )
+    return false;
+  accum >>= ( sextets == 2 ) ? 4 : 2;
+  if( tailBytes == 2 )
+    out[ size++ ] = static_cast<uint8_t>( accum >> 8 );
+  if( tailBytes != 0 )
+    out[ size++ ] = static_cast<uint8_t>( accum );
+  return true;
+}
+
+// Appends the decoded bytes to out; out is unchanged on failure
+inline bool AppendBase64Decoded( std::vector<uint8_t>& out, std::string_view str,
+                                 Base64Alphabet alphabet = Base64Alphabet::Standard, DecodeMode mode = DecodeMode::Strict )
+{
+  auto oldSize = out.size();
+  size_t size = GetBase64DecodedMaxLength( str.size() );
+  out.resize( oldSize + size );
+  bool isDecoded = Base64Decode( str, out.data() + oldSize, size, alphabet, mode );
+  out.resize( oldSize + ( isDecoded ? size : 0 ) );
+  return isDecoded;
+}
+
+// Lowercase hex; returns the characters written, which is always twice the byte count
+inline size_t HexEncode( std::span<const uint8_t> bytes, char* out ) noexcept
+{
+  size_t i = 0;
+#if defined( _M_X64 ) || defined( __SSE2__ )
+  i = Detail::EncodeHexBlocks( bytes, out );
+  out += i * 2;
+#endif
+  for( auto byte : bytes.subspan( i ) )
+  {
+    *out++ = Detail::kHexChars[ byte >> 4 ];
+    *out++ = Detail::kHexChars[ byte & 0xF ];
+  }
+  return bytes.size() * 2;
+}
+
+inline void AppendHex( std::string& out, std::span<const uint8_t> bytes )
+{
+  auto size = out.size();
+  out.resize( size + ( bytes.size() * 2 ) );
+  HexEncode( bytes, out.data() + size );
+}
+
+inline std::string GetHex( std::span<const uint8_t> bytes )
+{
+  std::string hex;
+  AppendHex( hex, bytes );
+  return hex;
+}
+
+// Either case is accepted; lenient mode also skips whitespace between digits
+inline bool HexDecode( std::string_view str, uint8_t* out, size_t& size, DecodeMode mode = DecodeMode::Strict ) noexcept
+{
+  const size_t capacity = size;
+  size = 0;
+  size_t pos = 0;
+  auto decodeBlocks = [&]()
+    {
+#if defined( _M_X64 ) || defined( __SSE2__ )
+      auto consumed = Detail::DecodeHexBlocks( str.substr( pos ), out + size, capacity - size );
+      pos += consumed;
+      size += consumed / 2;
+#endif
+    };
+  decodeBlocks();
+
+  int high = -1;
+  while( pos < str.size() )
+  {
+    auto value = Detail::kHexDecode[ static_cast<uint8_t>( str[ pos++ ] ) ];
+    if( value == Detail::kSpace && mode == DecodeMode::Lenient )
+    {
+      if( high < 0 )
+        decodeBlocks();
+      continue;
+    }
+    if( value < 0 )
+      return false;
+    if( high < 0 )
+    {
+      high = value;
+      continue;
+    }
+    if( size == capacity )
+      return false;
+    out[ size++ ] = static_cast<uint8_t>( ( high << 4 ) | value );
+    high = -1;
+  }
+  return high < 0;
+}
+
+// Appends the decoded bytes to out; out is unchanged on failure
+inline bool AppendHexDecoded( std::vector<uint8_t>& out, std::string_view str, DecodeMode mode = DecodeMode::Strict )
+{
+  auto oldSize = out.size();
+  size_t size = str.size() / 2;
+  out.resize( oldSize + size );
+  bool isDecoded = HexDecode( str, out.data() + oldSize, size, mode );
+  out.resize( oldSize + ( isDecoded ? size : 0 ) );
+  return isDecoded;
+}
+
+} // StringUtil
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template< typename C, typename A = std::allocator<C> >
+class StrListT;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Lazy range of string_views produced by splitting a string at each delimiter. No allocations
+// are made; each part refers into the original string, which must outlive the range. The
+// delimiter is a single character, a string, or a predicate such as CharUtilT<C>::IsWhitespace.
+// N delimiters yield N+1 parts unless empty parts are skipped.
+
+template< typename C, typename D >
+class StrSplitT : public std::ranges::view_interface< StrSplitT<C, D> >
+{
+private:
+
+  using viewT = std::basic_string_view<C>;
+
+  // Characters are stored as C, anything string-like as a view, everything else is a predicate
+  using DelimT = std::conditional_t< std::is_integral_v<D>, C,
+                 std::conditional_t< std::is_convertible_v<D, viewT>, viewT, D > >;
+
+  // Everything needed to find the parts; each iterator has its own copy, so iterators stay valid
+  // when the range is copied or moved
+  struct Source
+  {
+    viewT  str;
+    DelimT delimiter;
+    bool   skipEmpty;
+
+    // Returns position and length of the next delimiter at or after start. The string searches
+    // resolve to char_traits::find (memchr/wmemchr), which the CRT vectorizes.
+    std::pair<size_t, size_t> FindDelimiter( size_t start ) const
+    {
+      if constexpr( std::is_same_v<DelimT, C> )
+      {
+        return { str.find( delimiter, start ), 1 };
+      }
+      else if constexpr( std::is_same_v<DelimT, viewT> )
+      {
+        if( delimiter.empty() )
+          return { viewT::npos, 0 };
+        return { str.find( delimiter, start ), delimiter.size() };
+      }
+      else
+      {
+        auto i = std::find_if( std::begin( str ) + static_cast<ptrdiff_t>( start ), std::end( str ), delimiter );
+        if( i == std::end( str ) )
+          return { viewT::npos, 0 };
+        return { static_cast<size_t>( i - std::begin( str ) ), 1 };
+      }
+    }
+  };
+
+public:
+
+  class iterator
+  {
+  public:
+
+    using value_type       = viewT;
+    using difference_type  = std::ptrdiff_t;
+    using iterator_concept = std::forward_iterator_tag;
+
+    iterator() = default;
+
+    explicit iterator( const Source& source ) :
+      source_( source )
+    {
+      Advance( 0 );
+    }
+
+    iterator( const iterator& ) = default;
+
+    // Predicates such as capturing lambdas need not be assignable, so the source is recreated
+    iterator& operator=( const iterator& rhs )
+    {
+      if( this != &rhs )
+      {
+        source_.reset();
+        if( rhs.source_ )
+          source_.emplace( *rhs.source_ );
+        pos_ = rhs.pos_;
+        len_ = rhs.len_;
+        next_ = rhs.next_;
+      }
+      return *this;
+    }
+
+    viewT operator*() const
+    {
+      return source_->str.substr( pos_, len_ );
+    }
+
+    iterator& operator++()
+    {
+      Advance( next_ );
+      return *this;
+    }
+
+    iterator operator++( int )
+    {
+      auto prev( *this );
+      ++*this;
+      return prev;
+    }
+
+    bool operator==( const iterator& rhs ) const
+    {
+      return pos_ == rhs.pos_;
+    }
+
+    bool operator==( std::default_sentinel_t ) const
+    {
+      return pos_ == viewT::npos;
+    }
+
+  private:
+
+    void Advance( size_t start )
+    {
+      for( ;; )
+      {
+        // npos indicates the final part has already been visited
+        pos_ = start;
+        if( start == viewT::npos )
+          return;
+
+        auto [delimPos, delimLen] = source_->FindDelimiter( start );
+        if( delimPos == viewT::npos )
+        {
+          len_ = source_->str.size() - start;
+          next_ = viewT::npos;
+        }
+        else
+        {
+          len_ = delimPos - start;
+          next_ = delimPos + delimLen;
+        }
+
+        if( len_ != 0 || !source_->skipEmpty )
+          return;
+        start = next_;
+      }
+    }
+
+  private:
+
+    std::optional<Source> source_;
+    size_t pos_  = viewT::npos; // start of current part
+    size_t len_  = 0;           // length of current part
+    size_t next_ = viewT::npos; // start of following part
+
+  }; // iterator
+
+public:
+
+  StrSplitT( viewT str, D delimiter, bool skipEmpty ) :
+    source_{ str, static_cast<DelimT>( delimiter ), skipEmpty }
+  {
+  }
+
+  iterator begin() const { return iterator( source_ ); }
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+private:
+
+  Source source_;
+
+}; // StrSplitT
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename C>
+class StrUtilT
+{
+private:
+
+  using strT = std::basic_string<C>;
+  using viewT = std::basic_string_view<C>;
+  using pmrStrT = std::pmr::basic_string<C>;
+
+  // Any std::basic_string of C, regardless of allocator
+  template< typename A >
+  using strA = std::basic_string<C, std::char_traits<C>, A>;
+
+  // The characters replaced by ToXmlSafe, for use with find_first_of
+  static constexpr std::array<C, kXmlReplace.size()> kXmlSymbols = []()
+    {
+      std::array<C, kXmlReplace.size()> symbols = {};
+      for( size_t i = 0; i < kXmlReplace.size(); ++i )
+        symbols[ i ] = C( kXmlReplace[ i ].symbol );
+      return symbols;
+    }();
+  static constexpr C kXmlTextSymbols[] = { C( '&' ), C( '<' ), C( '>' ) };
+  static constexpr C kXmlDoubleQuoteSymbols[] = { C( '&' ), C( '<' ), C( '\"' ) };
+  static constexpr C kXmlSingleQuoteSymbols[] = { C( '&' ), C( '<' ), C( '\'' ) };
+
+  // The characters JSON requires escaping: controls, quote and backslash
+  static constexpr std::array<C, 0x22> kJsonSymbols = []()
+    {
+      std::array<C, 0x22> symbols = {};
+      for( size_t i = 0; i < 0x20; ++i )
+        symbols[ i ] = C( i );
+      symbols[ 0x20 ] = C( '\"' );
+      symbols[ 0x21 ] = C( '\\' );
+      return symbols;
+    }();
+
+public:
+
+	enum class AllowWildcards
+	{
+		No,
+		Yes
+	};
+
+  enum class ConvertWildcards
+  {
+    No,
+    Yes,
+    Remove
+  };
+
+  enum class EmptyParts
+  {
+    Keep,
+    Skip
+  };
+
+  // Where escaped text will appear. All escapes every special character; the other contexts
+  // escape only what the XML specification requires there, so output grows less:
+  //
+  //    Text                    &, < and the > of "]]>"
+  //    DoubleQuotedAttribute   &, < and "
+  //    SingleQuotedAttribute   &, < and '
+
+  enum class XmlContext
+  {
+    All,
+    Text,
+    DoubleQuotedAttribute,
+    SingleQuotedAttribute
+  };
+
+  // Replace special characters with XML markup
+  //
+  //    &  -->  &amp;
+  //    <  -->  &lt;
+  //    >  -->  &gt;
+  //    "  -->  &quot;
+  //    '  -->  &apos;
+
+  template< typename A >
+  static void ToXmlSafe( strA<A>& str, XmlContext context = XmlContext::All )
+  {
+    // Strings needing no changes are left alone; otherwise escape in one pass and swap
+    auto length = GetXmlSafeLength( str, context );
+    if( length == str.size() )
+      return;
+    strA<A> r( str.get_allocator() );
+    r.reserve( length );
+    AppendXmlSafe( r, str, context );
+    str.swap( r );
+  }
+
+  // Append the XML-safe version of str to out
+  template< typename A >
+  static void AppendXmlSafe( strA<A>& out, viewT str, XmlContext context = XmlContext::All )
+  {
+    EscapeXml( str, [&out]( viewT run ) { out.append( run ); }, context );
+  }
+
+  // Write the XML-safe version of str to an output iterator
+  template< typename OutIt >
+  static OutIt CopyXmlSafe( viewT str, OutIt out, XmlContext context = XmlContext::All )
+  {
+    EscapeXml( str, [&out]( viewT run ) { out = std::ranges::copy( run, out ).out; }, context );
+    return out;
+  }
+
+  // Single pass over str, calling emit( viewT ) for each run of characters that need no escaping
+  // and for the markup that replaces each special character. Runs are located with
+  // find_first_of, which the standard library vectorizes for small character sets.
+  template< typename Emit >
+  static void EscapeXml( viewT str, Emit emit, XmlContext context = XmlContext::All )
+  {
+    auto findSpecial = [context]( viewT s, size_t pos )
+      {
+        auto symbols = GetXmlSymbols( context );
+        for( pos = s.find_first_of( symbols, pos ); pos != viewT::npos; pos = s.find_first_of( symbols, pos + 1 ) )
+        {
+          if( context != XmlContext::Text || IsTextEscapeNeeded( s, pos ) )
+            break;
+        }
+        return pos;
+      };
+    auto escape = []( viewT s, size_t pos, auto& emitEscaped )
+      {
+        emitEscaped( GetXmlCode( s[ pos ] ) );
+        return size_t( 1 );
+      };
+    EscapeRuns( str, findSpecial, escape, emit );
+  }
+
+  // The single-pass framework shared by the escapers. findSpecial( str, pos ) returns the position
+  // of the next character at or after pos that needs escaping, or npos. escape( str, pos, emit )
+  // emits the replacement for the character at pos and returns the number of characters it
+  // consumed. Unchanged runs between special characters are emitted whole, without copying.
+  template< typename Find, typename Escape, typename Emit >
+  static void EscapeRuns( viewT str, Find findSpecial, Escape escape, Emit& emit )
+  {
+    size_t start = 0;
+    for( auto pos = findSpecial( str, start ); pos != viewT::npos; pos = findSpecial( str, start ) )
+    {
+      if( pos != start )
+        emit( str.substr( start, pos - start ) );
+      start = pos + escape( str, pos, emit );
+    }
+    if( start < str.size() )
+      emit( str.substr( start ) );
+  }
+
+  // The special characters escaped in the given context
+  static constexpr viewT GetXmlSymbols( XmlContext context = XmlContext::All )
+  {
+    switch( context )
+    {
+    case XmlContext::Text:                  return viewT( kXmlTextSymbols, std::size( kXmlTextSymbols ) );
+    case XmlContext::DoubleQuotedAttribute: return viewT( kXmlDoubleQuoteSymbols, std::size( kXmlDoubleQuoteSymbols ) );
+    case XmlContext::SingleQuotedAttribute: return viewT( kXmlSingleQuoteSymbols, std::size( kXmlSingleQuoteSymbols ) );
+    case XmlContext::All:
+    default:                                return viewT( kXmlSymbols.data(), kXmlSymbols.size() );
+    }
+  }
+
+  // The markup for one of the special characters, e.g. "&amp;" for '&'
+  static viewT GetXmlCode( C c )
+  {
+    for( const auto& specialXml : kXmlReplace )
+    {
+      if( c == C( specialXml.symbol ) )
+      {
+        if constexpr( sizeof( C ) == 1 )
+          return specialXml.xmlCode;
+        else
+          return specialXml.xmlWideCode;
+      }
+    }
+    return {};
+  }
+
+  // In element text, '>' only needs escaping where it would close "]]>"
+  static bool IsTextEscapeNeeded( viewT str, size_t pos )
+  {
+    return str[ pos ] != C( '>' ) || ( pos >= 2 && str[ pos - 1 ] == C( ']' ) && str[ pos - 2 ] == C( ']' ) );
+  }
+
+  static strT GetXmlSafe( const strT& str, XmlContext context = XmlContext::All )
+  {
+    strT r;
+    r.reserve( GetXmlSafeLength( str, context ) );
+    AppendXmlSafe( r, str, context );
+    return r;
+  }
+
+  static pmrStrT GetXmlSafe( viewT str, std::pmr::memory_resource* mr, XmlContext context = XmlContext::All )
+  {
+    pmrStrT r( mr );
+    r.reserve( GetXmlSafeLength( str, context ) );
+    AppendXmlSafe( r, str, context );
+    return r;
+  }
+
+  // Length of the XML-safe version of str, for sizing buffers exactly. One pass that finds the
+  // special characters the same way EscapeXml does, but only adds up the lengths.
+  static size_t GetXmlSafeLength( viewT str, XmlContext context = XmlContext::All )
+  {
+    size_t length = 0;
+    EscapeXml( str, [&length]( viewT run ) { length += run.size(); }, context );
+    return length;
+  }
+
+  // Reverse XML escaping in place: the kXmlReplace entities and numeric character references
+  // such as &#65; and &#x41; are decoded, the latter to UTF-8 for char and UTF-16 or UTF-32 for
+  // wider characters. Decoded text is always shorter, so the string never grows. References that
+  // are malformed or unknown are left as is, and false is returned.
+
+  template< typename A >
+  static bool ToXmlUnescaped( strA<A>& str )
+  {
+    auto size = str.size();
+    bool isDecoded = ToXmlUnescaped( str.data(), size );
+    str.resize( size );
+    return isDecoded;
+  }
+
+  // Decode buffer[ 0, size ) in place, updating size
+  static bool ToXmlUnescaped( C* buffer, size_t& size )
+  {
+    viewT in( buffer, size );
+    size_t read = in.find( C( '&' ) );
+    if( read == viewT::npos )
+      return true;
+
+    bool isDecoded = true;
+    size_t write = read;
+    while( read < size )
+    {
+      // buffer[ read ] is '&'. The reference is decoded completely before anything is written,
+      // and output never overtakes input, so runs can be moved down safely.
+      const size_t kMaxReference = 12; // e.g. "&#x10FFFF;"
+      auto semicolon = in.substr( read, kMaxReference ).find( C( ';' ) );
+      C decoded[ 4 ];
+      size_t decodedLength = 0;
+      if( semicolon != viewT::npos )
+        decodedLength = DecodeXmlReference( in.substr( read + 1, semicolon - 1 ), decoded );
+      if( decodedLength != 0 )
+      {
+        std::char_traits<C>::copy( buffer + write, decoded, decodedLength );
+        write += decodedLength;
+        read += semicolon + 1;
+      }
+      else
+      {
+        isDecoded = false;
+        buffer[ write++ ] = buffer[ read++ ];
+      }
+
+      auto next = std::min( in.find( C( '&' ), read ), size );
+      std::char_traits<C>::move( buffer + write, buffer + read, next - read );
+      write += next - read;
+      read = next;
+    }
+    size = write;
+    return isDecoded;
+  }
+
+  static strT GetXmlUnescaped( viewT str )
+  {
+    strT r( str );
+    ToXmlUnescaped( r );
+    return r;
+  }
+
+  // Decode the reference name between '&' and ';' into out; returns the characters written, or
+  // zero if the name isn't recognized
+  static size_t DecodeXmlReference( viewT name, C* out )
+  {
+    if( name.size() >= 2 && name[ 0 ] == C( '#' ) )
+    {
+      bool isHex = ( name[ 1 ] == C( 'x' ) || name[ 1 ] == C( 'X' ) );
+      auto digits = name.substr( isHex ? 2 : 1 );
+      if( digits.empty() || digits.size() > 8 )
+        return 0;
+      uint32_t codePoint = 0;
+      for( auto c : digits )
+      {
+        uint32_t digit;
+        if( c >= C( '0' ) && c <= C( '9' ) )
+          digit = uint32_t( c - C( '0' ) );
+        else if( isHex && c >= C( 'a' ) && c <= C( 'f' ) )
+          digit = uint32_t( c - C( 'a' ) + 10 );
+        else if( isHex && c >= C( 'A' ) && c <= C( 'F' ) )
+          digit = uint32_t( c - C( 'A' ) + 10 );
+        else
+          return 0;
+        codePoint = ( codePoint * ( isHex ? 16 : 10 ) ) + digit;
+      }
+      return EncodeCodePoint( codePoint, out );
+    }
+
+    for( auto symbol : GetXmlSymbols() )
+    {
+      auto code = GetXmlCode( symbol );
+      if( name == code.substr( 1, code.size() - 2 ) )
+      {
+        out[ 0 ] = symbol;
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  // Encode a Unicode code point as UTF-8, UTF-16 or UTF-32 depending on the size of C; returns
+  // the characters written, or zero if the code point is invalid
+  static size_t EncodeCodePoint( uint32_t codePoint, C* out )
+  {
+    if( codePoint == 0 || codePoint > 0x10FFFF || ( codePoint >= 0xD800 && codePoint <= 0xDFFF ) )
+      return 0;
+    if constexpr( sizeof( C ) == 1 )
+    {
+      if( codePoint < 0x80 )
+      {
+        out[ 0 ] = C( codePoint );
+        return 1;
+      }
+      if( codePoint < 0x800 )
+      {
+        out[ 0 ] = C( 0xC0 | ( codePoint >> 6 ) );
+        out[ 1 ] = C( 0x80 | ( codePoint & 0x3F ) );
+        return 2;
+      }
+      if( codePoint < 0x10000 )
+      {
+        out[ 0 ] = C( 0xE0 | ( codePoint >> 12 ) );
+        out[ 1 ] = C( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+        out[ 2 ] = C( 0x80 | ( codePoint & 0x3F ) );
+        return 3;
+      }
+      out[ 0 ] = C( 0xF0 | ( codePoint >> 18 ) );
+      out[ 1 ] = C( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+      out[ 2 ] = C( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+      out[ 3 ] = C( 0x80 | ( codePoint & 0x3F ) );
+      return 4;
+    }
+    else if constexpr( sizeof( C ) == 2 )
+    {
+      if( codePoint < 0x10000 )
+      {
+        out[ 0 ] = C( codePoint );
+        return 1;
+      }
+      codePoint -= 0x10000;
+      out[ 0 ] = C( 0xD800 | ( codePoint >> 10 ) );
+      out[ 1 ] = C( 0xDC00 | ( codePoint & 0x3FF ) );
+      return 2;
+    }
+    else
+    {
+      out[ 0 ] = C( codePoint );
+      return 1;
+    }
+  }
+
+  // Escape for use inside a JSON string: quote and backslash are backslash escaped, control
+  // characters use the short forms \b \f \n \r \t where JSON has them and \u00XX otherwise.
+  // Optionally, non-ASCII characters are escaped as \uXXXX, using surrogate pairs beyond the BMP;
+  // char strings are decoded as UTF-8 for this, and invalid sequences become \ufffd.
+
+  enum class EscapeNonAscii
+  {
+    No,
+    Yes
+  };
+
+  template< typename A >
+  static void ToJsonSafe( strA<A>& str, EscapeNonAscii escapeNonAscii = EscapeNonAscii::No )
+  {
+    if( FindJsonSpecial( str, 0, escapeNonAscii ) == viewT::npos )
+      return;
+    strA<A> r( str.get_allocator() );
+    r.reserve( str.size() + ( str.size() / 8 ) );
+    AppendJsonSafe( r, str, escapeNonAscii );
+    str.swap( r );
+  }
+
+  template< typename A >
+  static void AppendJsonSafe( strA<A>& out, viewT str, EscapeNonAscii escapeNonAscii = EscapeNonAscii::No )
+  {
+    EscapeJson( str, [&out]( viewT run ) { out.append( run ); }, escapeNonAscii );
+  }
+
+  static strT GetJsonSafe( viewT str, EscapeNonAscii escapeNonAscii = EscapeNonAscii::No )
+  {
+    strT r;
+    AppendJsonSafe( r, str, escapeNonAscii );
+    return r;
+  }
+
+  // As EscapeXml; escaped sequences are passed to emit in a temporary buffer
+  template< typename Emit >
+  static void EscapeJson( viewT str, Emit emit, EscapeNonAscii escapeNonAscii = EscapeNonAscii::No )
+  {
+    auto findSpecial = [escapeNonAscii]( viewT s, size_t pos ) { return FindJsonSpecial( s, pos, escapeNonAscii ); };
+    auto escape = []( viewT s, size_t pos, auto& emitEscaped )
+      {
+        C escaped[ 12 ] = { C( '\\' ) };
+        size_t length = 2;
+        size_t consumed = 1;
+        switch( s[ pos ] )
+        {
+        case C( '\"' ):  escaped[ 1 ] = C( '\"' ); break;
+        case C( '\\' ): escaped[ 1 ] = C( '\\' ); break;
+        case C( '\b' ):  escaped[ 1 ] = C( 'b' ); break;
+        case C( '\f' ):  escaped[ 1 ] = C( 'f' ); break;
+        case C( '\n' ):  escaped[ 1 ] = C( 'n' ); break;
+        case C( '\r' ):  escaped[ 1 ] = C( 'r' ); break;
+        case C( '\t' ):  escaped[ 1 ] = C( 't' ); break;
+        default:
+          {
+            uint32_t codePoint = static_cast<std::make_unsigned_t<C>>( s[ pos ] );
+            if constexpr( sizeof( C ) == 1 )
+            {
+              if( codePoint > 0x7F )
+                consumed = DecodeUtf8( s.substr( pos ), codePoint );
+            }
+            length = FormatJsonCodePoint( codePoint, escaped );
+          }
+          break;
+        }
+        emitEscaped( viewT( escaped, length ) );
+        return consumed;
+      };
+    EscapeRuns( str, findSpecial, escape, emit );
+  }
+
+  // Position of the next character at or after pos that JSON requires escaping, or npos. char
+  // strings are scanned 16 bytes at a time with SSE2 where available; wider strings search for
+  // the fixed set of specials with find_first_of, which the standard library vectorizes.
+  static size_t FindJsonSpecial( viewT str, size_t pos, EscapeNonAscii escapeNonAscii )
+  {
+    pos = std::min( pos, str.size() );
+    if constexpr( sizeof( C ) == 1 )
+    {
+#if defined( _M_X64 ) || defined( __SSE2__ )
+      const __m128i kQuote = _mm_set1_epi8( '\"' );
+      const __m128i kBackslash = _mm_set1_epi8( '\\' );
+      const __m128i kControlMax = _mm_set1_epi8( 0x1F );
+      for( ; pos + 16 <= str.size(); pos += 16 )
+      {
+        auto block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( str.data() + pos ) );
+        auto special = _mm_or_si128( _mm_cmpeq_epi8( block, kQuote ), _mm_cmpeq_epi8( block, kBackslash ) );
+        special = _mm_or_si128( special, _mm_cmpeq_epi8( _mm_min_epu8( block, kControlMax ), block ) );
+        auto mask = static_cast<unsigned>( _mm_movemask_epi8( special ) );
+        if( escapeNonAscii == EscapeNonAscii::Yes )
+          mask |= static_cast<unsigned>( _mm_movemask_epi8( block ) ); // high bit set
+        if( mask != 0 )
+          return pos + static_cast<size_t>( std::countr_zero( mask ) );
+      }
+#endif
+    }
+    else if( escapeNonAscii == EscapeNonAscii::No )
+    {
+      return str.find_first_of( viewT( kJsonSymbols.data(), kJsonSymbols.size() ), pos );
+    }
+
+    auto isSpecial = [escapeNonAscii]( C c )
+      {
+        auto u = static_cast<std::make_unsigned_t<C>>( c );
+        return u < 0x20 || c == C( '\"' ) || c == C( '\\' ) || ( escapeNonAscii == EscapeNonAscii::Yes && u > 0x7F );
+      };
+    auto i = std::find_if( str.begin() + static_cast<ptrdiff_t>( pos ), str.end(), isSpecial );
+    return ( i == str.end() ) ? viewT::npos : static_cast<size_t>( i - str.begin() );
+  }
 
-// Conversions
+  // Write \uXXXX, or a surrogate pair of them, to out; returns the characters written. Values
+  // beyond Unicode, possible with 32-bit wchar_t, are written as \ufffd.
+  static size_t FormatJsonCodePoint( uint32_t codePoint, C* out )
+  {
+    if( codePoint > 0x10FFFF )
+      codePoint = 0xFFFD;
+    auto formatUnit = [out]( uint32_t unit, size_t at )
+      {
+        const char kHexDigits[] = "0123456789abcdef";
+        out[ at ] = C( '\\' );
+        out[ at + 1 ] = C( 'u' );
+        for( size_t i = 0; i < 4; ++i )
+          out[ at + 2 + i ] = C( kHexDigits[ ( unit >> ( 12 - ( i * 4 ) ) ) & 0xF ] );
+      };
+    if( codePoint < 0x10000 )
+    {
+      formatUnit( codePoint, 0 );
+      return 6;
+    }
+    codePoint -= 0x10000;
+    formatUnit( 0xD800 | ( codePoint >> 10 ), 0 );
+    formatUnit( 0xDC00 | ( codePoint & 0x3FF ), 6 );
+    return 12;
+  }
 
-namespace StringUtil {
+  // Decode the UTF-8 sequence at the start of str; returns the characters consumed. Invalid or
+  // truncated sequences consume one character and decode as U+FFFD.
+  static size_t DecodeUtf8( viewT str, uint32_t& codePoint )
+  {
+    auto lead = static_cast<uint8_t>( str[ 0 ] );
+    size_t length = ( lead >= 0xC2 && lead <= 0xDF ) ? 2 :
+                    ( lead >= 0xE0 && lead <= 0xEF ) ? 3 :
+                    ( lead >= 0xF0 && lead <= 0xF4 ) ? 4 : 0;
+    codePoint = 0xFFFD;
+    if( length == 0 || str.size() < length )
+      return 1;
+
+    uint32_t decoded = lead & ( 0x7F >> length );
+    for( size_t i = 1; i < length; ++i )
+    {
+      auto next = static_cast<uint8_t>( str[ i ] );
+      if( ( next & 0xC0 ) != 0x80 )
+        return 1;
+      decoded = ( decoded << 6 ) | ( next & 0x3F );
+    }
 
-template<typename T, typename F>
-inline T TransformTo( F str ) noexcept
-{
-  return { std::begin( str ), std::end( str ) };
-}
+    // Reject overlong forms, surrogates and values beyond Unicode
+    const uint32_t kMinForLength[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if( decoded < kMinForLength[ length ] || decoded > 0x10FFFF || ( decoded >= 0xD800 && decoded <= 0xDFFF ) )
+      return 1;
+    codePoint = decoded;
+    return length;
+  }
 
-#pragma warning(push)
-#pragma warning(disable: 4244) // ignore loss of data; it's expected
+  // Percent encoding for URLs (RFC 3986). Everything outside the unreserved set A-Z a-z 0-9 - . _ ~
+  // is encoded as %XX using uppercase hex. char strings are encoded byte by byte, so UTF-8 stays
+  // UTF-8; wider strings are encoded as UTF-8 first.
 
-inline std::string GetUtf8( std::wstring_view wstr )
-{
-  return TransformTo<std::string>( wstr );
-}
-#pragma warning(pop)
+  template< typename A >
+  static void ToUrlEncoded( strA<A>& str )
+  {
+    auto length = GetUrlEncodedLength( str );
+    if( length == str.size() )
+      return;
+    strA<A> r( str.get_allocator() );
+    r.reserve( length );
+    AppendUrlEncoded( r, str );
+    str.swap( r );
+  }
 
-inline std::wstring GetUtf16( std::string_view str )
-{
-  return TransformTo<std::wstring>( str );
-}
+  template< typename A >
+  static void AppendUrlEncoded( strA<A>& out, viewT str )
+  {
+    EscapeUrl( str, [&out]( viewT run ) { out.append( run ); } );
+  }
 
-} // StringUtil
+  static strT GetUrlEncoded( viewT str )
+  {
+    strT r;
+    r.reserve( GetUrlEncodedLength( str ) );
+    AppendUrlEncoded( r, str );
+    return r;
+  }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Exact length of the encoded form of str
+  static size_t GetUrlEncodedLength( viewT str )
+  {
+    if constexpr( sizeof( C ) == 1 )
+    {
+      size_t count = 0;
+      size_t pos = 0;
+#if defined( _M_X64 ) || defined( __SSE2__ )
+      for( ; pos + 16 <= str.size(); pos += 16 )
+        count += static_cast<size_t>( std::popcount( GetUrlReservedMask( str.data() + pos ) ) );
+#endif
+      count += static_cast<size_t>( std::ranges::count_if( str.substr( pos ), []( C c ) { return !CharUtilT<C>::IsUrlUnreserved( c ); } ) );
+      return str.size() + ( count * 2 );
+    }
+    else
+    {
+      size_t length = 0;
+      EscapeUrl( str, [&length]( viewT run ) { length += run.size(); } );
+      return length;
+    }
+  }
 
-template<typename C>
-class StrUtilT
-{
-private:
+  // As EscapeXml; encoded sequences are passed to emit in a temporary buffer
+  template< typename Emit >
+  static void EscapeUrl( viewT str, Emit emit )
+  {
+    auto escape = []( viewT s, size_t pos, auto& emitEscaped )
+      {
+        char bytes[ 4 ];
+        size_t byteCount = 1;
+        size_t consumed = 1;
+        if constexpr( sizeof( C ) == 1 )
+        {
+          bytes[ 0 ] = static_cast<char>( s[ pos ] );
+        }
+        else
+        {
+          uint32_t codePoint = static_cast<std::make_unsigned_t<C>>( s[ pos ] );
+          if constexpr( sizeof( C ) == 2 )
+          {
+            // Combine surrogate pairs; unpaired surrogates are invalid
+            if( codePoint >= 0xD800 && codePoint <= 0xDBFF && pos + 1 < s.size() &&
+                static_cast<uint32_t>( s[ pos + 1 ] ) >= 0xDC00 && static_cast<uint32_t>( s[ pos + 1 ] ) <= 0xDFFF )
+            {
+              codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( static_cast<uint32_t>( s[ pos + 1 ] ) - 0xDC00 );
+              consumed = 2;
+            }
+          }
+          if( codePoint < 0x80 )
+            bytes[ 0 ] = static_cast<char>( codePoint );
+          else
+          {
+            byteCount = StrUtilT<char>::EncodeCodePoint( codePoint, bytes );
+            if( byteCount == 0 )
+              byteCount = StrUtilT<char>::EncodeCodePoint( 0xFFFD, bytes );
+          }
+        }
+
+        const char kHexDigits[] = "0123456789ABCDEF";
+        C encoded[ 12 ];
+        for( size_t i = 0; i < byteCount; ++i )
+        {
+          auto byte = static_cast<uint8_t>( bytes[ i ] );
+          encoded[ ( i * 3 ) ] = C( '%' );
+          encoded[ ( i * 3 ) + 1 ] = C( kHexDigits[ byte >> 4 ] );
+          encoded[ ( i * 3 ) + 2 ] = C( kHexDigits[ byte & 0xF ] );
+        }
+        emitEscaped( viewT( encoded, byteCount * 3 ) );
+        return consumed;
+      };
+    EscapeRuns( str, FindUrlReserved, escape, emit );
+  }
 
-  using strT = std::basic_string<C>;
+  // Position of the next character at or after pos that must be percent encoded, or npos. char
+  // strings are scanned 16 bytes at a time with SSE2 where available.
+  static size_t FindUrlReserved( viewT str, size_t pos )
+  {
+    pos = std::min( pos, str.size() );
+    if constexpr( sizeof( C ) == 1 )
+    {
+#if defined( _M_X64 ) || defined( __SSE2__ )
+      for( ; pos + 16 <= str.size(); pos += 16 )
+      {
+        auto mask = GetUrlReservedMask( str.data() + pos );
+        if( mask != 0 )
+          return pos + static_cast<size_t>( std::countr_zero( mask ) );
+      }
+#endif
+    }
+    auto i = std::find_if_not( str.begin() + static_cast<ptrdiff_t>( pos ), str.end(), CharUtilT<C>::IsUrlUnreserved );
+    return ( i == str.end() ) ? viewT::npos : static_cast<size_t>( i - str.begin() );
+  }
 
-public:
+#if defined( _M_X64 ) || defined( __SSE2__ )
+  // One bit per byte of the 16 at p that is outside the unreserved set; bytes above 0x7F compare
+  // as negative and so fall outside every range
+  static unsigned GetUrlReservedMask( const C* p )
+  {
+    auto block = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+    auto inRange = [block]( char lo, char hi )
+      {
+        return _mm_and_si128( _mm_cmpgt_epi8( block, _mm_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                              _mm_cmplt_epi8( block, _mm_set1_epi8( static_cast<char>( hi + 1 ) ) ) );
+      };
+    auto unreserved = _mm_or_si128( _mm_or_si128( inRange( 'A', 'Z' ), inRange( 'a', 'z' ) ), inRange( '0', '9' ) );
+    for( auto c : { '-', '.', '_', '~' } )
+      unreserved = _mm_or_si128( unreserved, _mm_cmpeq_epi8( block, _mm_set1_epi8( c ) ) );
+    return static_cast<unsigned>( _mm_movemask_epi8( unreserved ) ) ^ 0xFFFFu;
+  }
+#endif
 
-	enum class AllowWildcards
-	{
-		No,
-		Yes
-	};
+  // Decode %XX sequences in place. Decoded text is always shorter, so the string never grows.
+  // For wider strings the decoded bytes are treated as UTF-8. Malformed sequences are left as is,
+  // and false is returned.
 
-  enum class ConvertWildcards
+  template< typename A >
+  static bool ToUrlDecoded( strA<A>& str )
   {
-    No,
-    Yes,
-    Remove
-  };
-
-  // Replace special characters with XML markup
-  //
-  //    &  -->  &amp;
-  //    <  -->  &lt;
-  //    >  -->  &gt;
-  //    "  -->  &quot;
-  //    '  -->  &apos;
+    auto size = str.size();
+    bool isDecoded = ToUrlDecoded( str.data(), size );
+    str.resize( size );
+    return isDecoded;
+  }
 
-  static void ToXmlSafe( strT& str )
+  // Decode buffer[ 0, size ) in place, updating size
+  static bool ToUrlDecoded( C* buffer, size_t& size )
   {
-    size_t index = 0;
-    for( const auto& specialXml : kXmlReplace )
+    viewT in( buffer, size );
+    size_t read = in.find( C( '%' ) );
+    if( read == viewT::npos )
+      return true;
+
+    bool isDecoded = true;
+    size_t write = read;
+    while( read < size )
     {
-      // Replace each special character with the proper code
-      auto pos = str.find( C( specialXml.symbol ) );
-      while( pos != strT::npos )
+      // buffer[ read ] is '%'
+      C decoded[ 2 ];
+      size_t decodedLength = 0;
+      size_t consumed = DecodeUrlSequence( in, read, decoded, decodedLength );
+      if( consumed != 0 )
       {
-        if constexpr( sizeof(strT::value_type) == 1 )
-          str.replace( pos, 1, kXmlReplace[ index ].xmlCode );
-        else
-          str.replace( pos, 1, kXmlReplace[ index ].xmlWideCode );
-        pos = str.find( C( specialXml.symbol ), pos+1 );
+        std::char_traits<C>::copy( buffer + write, decoded, decodedLength );
+        write += decodedLength;
+        read += consumed;
+      }
+      else
+      {
+        isDecoded = false;
+        buffer[ write++ ] = buffer[ read++ ];
       }
-      ++index;
+
+      auto next = std::min( in.find( C( '%' ), read ), size );
+      std::char_traits<C>::move( buffer + write, buffer + read, next - read );
+      write += next - read;
+      read = next;
     }
+    size = write;
+    return isDecoded;
   }
 
-  static strT GetXmlSafe( const strT& str )
+  static strT GetUrlDecoded( viewT str )
   {
-    auto r( str );
-    ToXmlSafe( r );
+    strT r( str );
+    ToUrlDecoded( r );
     return r;
   }
 
+  // Value of the %XX at pos, or -1 if there isn't one
+  static int GetPercentByte( viewT str, size_t pos )
+  {
+    if( pos + 2 >= str.size() || str[ pos ] != C( '%' ) )
+      return -1;
+    auto hexValue = []( C c )
+      {
+        if( c >= C( '0' ) && c <= C( '9' ) )
+          return int( c - C( '0' ) );
+        if( c >= C( 'a' ) && c <= C( 'f' ) )
+          return int( c - C( 'a' ) + 10 );
+        if( c >= C( 'A' ) && c <= C( 'F' ) )
+          return int( c - C( 'A' ) + 10 );
+        return -1;
+      };
+    auto high = hexValue( str[ pos + 1 ] );
+    auto low = hexValue( str[ pos + 2 ] );
+    return ( high < 0 || low < 0 ) ? -1 : ( high << 4 ) | low;
+  }
+
+  // Decode the percent-encoded character at pos into out; returns the characters consumed, or
+  // zero if the sequence is malformed
+  static size_t DecodeUrlSequence( viewT str, size_t pos, C* out, size_t& outLength )
+  {
+    auto lead = GetPercentByte( str, pos );
+    if( lead < 0 )
+      return 0;
+    outLength = 1;
+    if constexpr( sizeof( C ) == 1 )
+    {
+      out[ 0 ] = static_cast<C>( lead );
+      return 3;
+    }
+    else
+    {
+      if( lead < 0x80 )
+      {
+        out[ 0 ] = C( lead );
+        return 3;
+      }
+
+      // Gather the rest of the UTF-8 sequence
+      char bytes[ 4 ] = { static_cast<char>( lead ) };
+      size_t byteCount = 1;
+      while( byteCount < 4 )
+      {
+        auto next = GetPercentByte( str, pos + ( byteCount * 3 ) );
+        if( next < 0 || ( next & 0xC0 ) != 0x80 )
+          break;
+        bytes[ byteCount++ ] = static_cast<char>( next );
+      }
+      uint32_t codePoint;
+      auto length = StrUtilT<char>::DecodeUtf8( std::string_view( bytes, byteCount ), codePoint );
+      if( length < 2 )
+        return 0;
+      outLength = EncodeCodePoint( codePoint, out );
+      return length * 3;
+    }
+  }
+
   // Trim leading characters
   // e.g. to trim leading white space, call ToTrimmedLeading( str, " \t" )
   
-  static void ToTrimmedLeading( strT& str, const strT& trimCharset )
+  template< typename A >
+  static void ToTrimmedLeading( strA<A>& str, viewT trimCharset )
   {
     // Find the first character that's not in the character set. If all characters
     // are in the set, clear the string and bail out.
@@ -154,34 +1737,86 @@ public:
     str.assign( str, firstNot, str.size() - firstNot + 1 );
   }
 
-  static strT GetTrimmedLeading( const strT& str, const strT& trimCharset )
+  static strT GetTrimmedLeading( const strT& str, viewT trimCharset )
   {
     auto r( str );
     ToTrimmedLeading( r, trimCharset );
     return r;
   }
+
+  template< typename A >
+  static void AppendTrimmedLeading( strA<A>& out, viewT str, viewT trimCharset )
+  {
+    out.append( GetTrimmedLeadingView( str, trimCharset ) );
+  }
+
+  template< typename OutIt >
+  static OutIt CopyTrimmedLeading( viewT str, viewT trimCharset, OutIt out )
+  {
+    return std::ranges::copy( GetTrimmedLeadingView( str, trimCharset ), out ).out;
+  }
+
+  static viewT GetTrimmedLeadingView( viewT str, viewT trimCharset )
+  {
+    auto firstNot = str.find_first_not_of( trimCharset );
+    return ( firstNot == viewT::npos ) ? viewT() : str.substr( firstNot );
+  }
+
+  static pmrStrT GetTrimmedLeading( viewT str, viewT trimCharset, std::pmr::memory_resource* mr )
+  {
+    pmrStrT r( str, mr );
+    ToTrimmedLeading( r, trimCharset );
+    return r;
+  }
   
   // Trim trailing characters
   // e.g. to trim trailing white space, call ToTrimmedTrailing( str, " \t" )
   
-  static void ToTrimmedTrailing( strT& str, const strT& trimCharset )
+  template< typename A >
+  static void ToTrimmedTrailing( strA<A>& str, viewT trimCharset )
   {
     // Find the last character that's not in the character set
     auto lastNot = str.find_last_not_of( trimCharset );
     str.resize( (lastNot == strT::npos) ? 0 : (lastNot + 1) );
   }
 
-  static strT GetTrimmedTrailing( const strT& str, const strT& trimCharset )
+  static strT GetTrimmedTrailing( const strT& str, viewT trimCharset )
   {
     auto r( str );
     ToTrimmedTrailing( r, trimCharset );
     return r;
   }
+
+  template< typename A >
+  static void AppendTrimmedTrailing( strA<A>& out, viewT str, viewT trimCharset )
+  {
+    out.append( GetTrimmedTrailingView( str, trimCharset ) );
+  }
+
+  template< typename OutIt >
+  static OutIt CopyTrimmedTrailing( viewT str, viewT trimCharset, OutIt out )
+  {
+    return std::ranges::copy( GetTrimmedTrailingView( str, trimCharset ), out ).out;
+  }
+
+  static viewT GetTrimmedTrailingView( viewT str, viewT trimCharset )
+  {
+    auto lastNot = str.find_last_not_of( trimCharset );
+    return str.substr( 0, ( lastNot == viewT::npos ) ? 0 : ( lastNot + 1 ) );
+  }
+
+  static pmrStrT GetTrimmedTrailing( viewT str, viewT trimCharset, std::pmr::memory_resource* mr )
+  {
+    pmrStrT r( str, mr );
+    ToTrimmedTrailing( r, trimCharset );
+    return r;
+  }
   
   // Trim leading and trailing characters
   // e.g. to trim leading/trailing white space, call ToTrimmed( str, " \t" )
   
-  static void ToTrimmed( strT& str, const strT& trimCharset )
+  template< typename A >
+  static void ToTrimmed( strA<A>& str, viewT trimCharset )
   {
     // Find the first character that's not in the character set. If all characters
     // are in the set, clear the string and bail out.
@@ -200,13 +1835,37 @@ public:
     str.assign( str, firstNot, lastNot - firstNot + 1 );
   }
 
-  static strT GetTrimmed( const strT& str, const strT& trimCharset )
+  static strT GetTrimmed( const strT& str, viewT trimCharset )
   {
     auto r( str );
     ToTrimmed( r, trimCharset );
     return r;
   }
 
+  template< typename A >
+  static void AppendTrimmed( strA<A>& out, viewT str, viewT trimCharset )
+  {
+    out.append( GetTrimmedView( str, trimCharset ) );
+  }
+
+  template< typename OutIt >
+  static OutIt CopyTrimmed( viewT str, viewT trimCharset, OutIt out )
+  {
+    return std::ranges::copy( GetTrimmedView( str, trimCharset ), out ).out;
+  }
+
+  static viewT GetTrimmedView( viewT str, viewT trimCharset )
+  {
+    return GetTrimmedTrailingView( GetTrimmedLeadingView( str, trimCharset ), trimCharset );
+  }
+
+  static pmrStrT GetTrimmed( viewT str, viewT trimCharset, std::pmr::memory_resource* mr )
+  {
+    pmrStrT r( str, mr );
+    ToTrimmed( r, trimCharset );
+    return r;
+  }
+
   static bool IsDigit( const strT& str )
   {
     return !str.empty() && std::ranges::all_of( str, CharUtilT<C>::IsDigit );
@@ -256,7 +1915,8 @@ public:
     return std::ranges::any_of( str, CharUtilT<C>::IsWildcardFileChar );
   }
   
-  static void ToGoodFileName( strT& str, ConvertWildcards convertWildcards )
+  template< typename A >
+  static void ToGoodFileName( strA<A>& str, ConvertWildcards convertWildcards )
   {
     using namespace std::ranges;
     auto result = std::begin( str );
@@ -285,12 +1945,64 @@ public:
     return r;
   }
 
-  static void ToUpper( strT& str )
+  template< typename A >
+  static void AppendGoodFileName( strA<A>& out, viewT str, ConvertWildcards convertWildcards )
+  {
+    out.reserve( out.size() + GetGoodFileNameLength( str, convertWildcards ) );
+    CopyGoodFileName( str, convertWildcards, std::back_inserter( out ) );
+  }
+
+  // Length of the good file name version of str; only ConvertWildcards::Remove changes the length
+  static size_t GetGoodFileNameLength( viewT str, ConvertWildcards convertWildcards )
+  {
+    size_t length = str.size();
+    if( convertWildcards == ConvertWildcards::Remove )
+    {
+      for( const auto& wildcard : kWildcardChars )
+        length -= static_cast<size_t>( std::ranges::count( str, C( wildcard.special ) ) );
+    }
+    return length;
+  }
+
+  template< typename OutIt >
+  static OutIt CopyGoodFileName( viewT str, ConvertWildcards convertWildcards, OutIt out )
+  {
+    for( auto c : str )
+    {
+      switch( convertWildcards )
+      {
+      default:
+        [[fallthrough]];
+      case ConvertWildcards::No:
+        *out++ = CharUtilT<C>::ToGoodFileChar( c );
+        break;
+      case ConvertWildcards::Yes:
+        *out++ = CharUtilT<C>::ToGoodFileCharConvertWildcards( c );
+        break;
+      case ConvertWildcards::Remove:
+        if( !CharUtilT<C>::IsWildcardFileChar( c ) )
+          *out++ = CharUtilT<C>::ToGoodFileChar( c );
+        break;
+      }
+    }
+    return out;
+  }
+
+  static pmrStrT GetGoodFileName( viewT str, ConvertWildcards convertWildcards, std::pmr::memory_resource* mr )
+  {
+    pmrStrT r( str, mr );
+    ToGoodFileName( r, convertWildcards );
+    return r;
+  }
+
+  template< typename A >
+  static void ToUpper( strA<A>& str )
   {
     std::ranges::transform( str, std::begin(str), CharUtilT<C>::ToUpper );
   }
 
-  static void ToLower( strT& str )
+  template< typename A >
+  static void ToLower( strA<A>& str )
   {
     std::ranges::transform( str, std::begin(str), CharUtilT<C>::ToLower );
   }
@@ -309,8 +2021,71 @@ public:
     return r;
   }
 
+  template< typename A >
+  static void AppendUpper( strA<A>& out, viewT str )
+  {
+    auto size = out.size();
+    out.resize( size + str.size() );
+    std::ranges::transform( str, std::begin( out ) + static_cast<ptrdiff_t>( size ), CharUtilT<C>::ToUpper );
+  }
+
+  template< typename A >
+  static void AppendLower( strA<A>& out, viewT str )
+  {
+    auto size = out.size();
+    out.resize( size + str.size() );
+    std::ranges::transform( str, std::begin( out ) + static_cast<ptrdiff_t>( size ), CharUtilT<C>::ToLower );
+  }
+
+  template< typename OutIt >
+  static OutIt CopyUpper( viewT str, OutIt out )
+  {
+    return std::ranges::transform( str, out, CharUtilT<C>::ToUpper ).out;
+  }
+
+  template< typename OutIt >
+  static OutIt CopyLower( viewT str, OutIt out )
+  {
+    return std::ranges::transform( str, out, CharUtilT<C>::ToLower ).out;
+  }
+
+  static pmrStrT GetUpper( viewT str, std::pmr::memory_resource* mr )
+  {
+    pmrStrT r( str, mr );
+    ToUpper( r );
+    return r;
+  }
+
+  static pmrStrT GetLower( viewT str, std::pmr::memory_resource* mr )
+  {
+    pmrStrT r( str, mr );
+    ToLower( r );
+    return r;
+  }
+
   // Format as DDd:HHh:MMm:SSs
   static strT GetDurationStr( uint64_t totalSeconds, uint64_t minDays = 3uL )
+  {
+    strT duration;
+    AppendDurationStr( duration, totalSeconds, minDays );
+    return duration;
+  }
+
+  static pmrStrT GetDurationStr( uint64_t totalSeconds, uint64_t minDays, std::pmr::memory_resource* mr )
+  {
+    pmrStrT duration( mr );
+    AppendDurationStr( duration, totalSeconds, minDays );
+    return duration;
+  }
+
+  template< typename A >
+  static void AppendDurationStr( strA<A>& out, uint64_t totalSeconds, uint64_t minDays = 3uL )
+  {
+    CopyDurationStr( totalSeconds, std::back_inserter( out ), minDays );
+  }
+
+  template< typename OutIt >
+  static OutIt CopyDurationStr( uint64_t totalSeconds, OutIt out, uint64_t minDays = 3uL )
   {
     const auto kSecondsPerHour = uint64_t(60 * 60);
     const auto kHoursPerDay = 24uL;
@@ -326,17 +2101,35 @@ public:
     // Only include days if there are at least minDays (e.g. 3)
     if( totalDays >= minDays )
     {
-      strT duration{ std::format( "{}d:", totalDays ) };
+      out = std::format_to( out, "{}d:", totalDays );
       totalSeconds -= totalDays * kSecondsPerDay;
       std::chrono::seconds sec{ totalSeconds };
-      duration += std::vformat( kHhMmSs, std::make_format_args( sec ) );
-      return duration;
+      return std::vformat_to( out, kHhMmSs, std::make_format_args( sec ) );
     }
 
     // Don't include hours unless there is at least one
     std::string_view timeFormat{ totalHours == 0uL ? kMmSs : kHhMmSs };
     std::chrono::seconds sec{ totalSeconds };
-    return std::vformat( timeFormat, std::make_format_args( sec ) );
+    return std::vformat_to( out, timeFormat, std::make_format_args( sec ) );
+  }
+
+  // Split into a lazy range of views into str; no allocations are made.
+  // e.g. for( auto field : StrUtil::Split( csvLine, ',' ) ) ...
+  // The delimiter may be a character, a string or a predicate like CharUtilT<C>::IsWhitespace.
+
+  template< typename D >
+  static StrSplitT<C, D> Split( viewT str, D delimiter, EmptyParts emptyParts = EmptyParts::Keep )
+  {
+    return StrSplitT<C, D>( str, delimiter, emptyParts == EmptyParts::Skip );
+  }
+
+  template< typename D >
+  static StrListT<C> GetSplit( viewT str, D delimiter, EmptyParts emptyParts = EmptyParts::Keep )
+  {
+    StrListT<C> list;
+    for( auto part : Split( str, delimiter, emptyParts ) )
+      list.push_back( strT( part ) );
+    return list;
   }
 
 }; // StrUtilT
@@ -348,17 +2141,19 @@ using StrUtilW = StrUtilT<wchar_t>;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// vector of std::string
-template< typename C >
+// vector of std::string; A is the character allocator, rebound for the vector itself
+template< typename C, typename A >
 class StrListT
 {
 private:
 
-  using strT = std::basic_string< C >;
-  using List = std::vector< strT >;
+  using strT = std::basic_string< C, std::char_traits< C >, A >;
+  using viewT = std::basic_string_view< C >;
+  using List = std::vector< strT, typename std::allocator_traits< A >::template rebind_alloc< strT > >;
   
 public:
 
+  using allocator_type  = typename List::allocator_type;
   using value_type      = typename List::value_type;
   using size_type       = typename List::size_type;
   using difference_type = typename List::difference_type;
@@ -375,8 +2170,12 @@ public:
   StrListT& operator=( const StrListT& ) = default;
   StrListT& operator=( StrListT&& ) = default;
 
+  explicit StrListT( const allocator_type& alloc ) : list_( alloc ) {}
+
   template<typename InIt>
-  StrListT( InIt start, InIt end ) : list_( start, end ) {}
+  StrListT( InIt start, InIt end, const allocator_type& alloc = allocator_type() ) : list_( start, end, alloc ) {}
+
+  allocator_type get_allocator() const { return list_.get_allocator(); }
 
   iterator begin()              { return list_.begin(); }
   const_iterator begin() const  { return list_.begin(); }
@@ -389,7 +2188,18 @@ public:
   size_type size() const { return list_.size(); }
 	
   void push_back( const strT& str ) { list_.push_back( str ); }
+  void push_back( strT&& str ) { list_.push_back( std::move( str ) ); }
+
+  // Anything else string-like is constructed in place with the list's allocator, with no temporary
+  template< typename S >
+    requires std::is_convertible_v<const S&, viewT> && ( !std::is_same_v<S, strT> )
+  void push_back( const S& str ) { list_.emplace_back( viewT( str ) ); }
+
+  template< typename... Args >
+  reference emplace_back( Args&&... args ) { return list_.emplace_back( std::forward<Args>( args )... ); }
+
   void clear() { list_.clear(); }
+  void reserve( size_type count ) { list_.reserve( count ); }
 
   template< class InIt >
   void insert( iterator where, InIt first, InIt last )
@@ -397,7 +2207,7 @@ public:
     list_.insert( where, first, last );
   }
 
-  bool find( const strT& str ) const // TODO contains?
+  bool find( viewT str ) const // TODO contains?
   {
     return std::ranges::contains( list_, str );
   }
@@ -418,14 +2228,80 @@ public:
     return std::accumulate( begin(), end(), size_t( 0 ), sumStrSizes );
   }
 
+  // Number of characters in the result of joining with a separator of the given size
+  size_t GetJoinedCharCount( size_t separatorSize ) const
+  {
+    return empty() ? 0 : GetCharCount() + ( separatorSize * ( size() - 1 ) );
+  }
+
+  // Concatenate all strings with separator between each; the result is allocated exactly once
+  strT Join( viewT separator ) const
+  {
+    strT result( A( list_.get_allocator() ) );
+    JoinTo( result, separator );
+    return result;
+  }
+
+  template< typename Xform >
+  strT Join( viewT separator, Xform xform ) const
+  {
+    strT result( A( list_.get_allocator() ) );
+    JoinTo( result, separator, xform );
+    return result;
+  }
+
+  // Append the joined strings to out
+  void JoinTo( strT& out, viewT separator ) const
+  {
+    out.reserve( out.size() + GetJoinedCharCount( separator.size() ) );
+    JoinTo( out, separator, []( strT& o, const strT& str ) { o.append( str ); } );
+  }
+
+  // Append the joined strings to out, where xform( out, str ) appends a transformed copy of
+  // each string, e.g. an XML-escaped version. The untransformed length is reserved up front.
+  template< typename Xform >
+  void JoinTo( strT& out, viewT separator, Xform xform ) const
+  {
+    out.reserve( out.size() + GetJoinedCharCount( separator.size() ) );
+    for( auto i = begin(); i != end(); ++i )
+    {
+      if( i != begin() )
+        out.append( separator );
+      xform( out, *i );
+    }
+  }
+
+  // Write the joined strings to a caller-supplied buffer. Returns the number of characters
+  // written, which may be zero, or nullopt with nothing written if the buffer is smaller than
+  // GetJoinedCharCount(). No null is appended.
+  std::optional<size_t> JoinTo( C* buffer, size_t bufferSize, viewT separator ) const
+  {
+    if( bufferSize < GetJoinedCharCount( separator.size() ) )
+      return std::nullopt;
+
+    using traits = typename strT::traits_type;
+    C* dest = buffer;
+    for( auto i = begin(); i != end(); ++i )
+    {
+      if( i != begin() )
+      {
+        traits::copy( dest, separator.data(), separator.size() );
+        dest += separator.size();
+      }
+      traits::copy( dest, i->data(), i->size() );
+      dest += i->size();
+    }
+    return static_cast<size_t>( dest - buffer );
+  }
+
 private:
 
   List list_;	
 
 }; // StrListT
 
-template< typename C >
-bool operator == ( const StrListT<C>& lhs, const StrListT<C>& rhs )
+template< typename C, typename A >
+bool operator == ( const StrListT<C, A>& lhs, const StrListT<C, A>& rhs )
 {
   if( lhs.size() != rhs.size() )
     return false;
@@ -438,6 +2314,19 @@ bool operator == ( const StrListT<C>& lhs, const StrListT<C>& rhs )
 using StrList = StrListT<char>;
 using StrListW = StrListT<wchar_t>;
 
+// Lists whose vector and strings all allocate from a std::pmr::memory_resource, e.g.
+// StrListT<char> list( &arena ), where arena is a std::pmr::monotonic_buffer_resource
+
+namespace pmr {
+
+template< typename C >
+using StrListT = PKIsensee::StrListT< C, std::pmr::polymorphic_allocator< C > >;
+
+using StrList = StrListT<char>;
+using StrListW = StrListT<wchar_t>;
+
+} // pmr
+
 } // PKIsensee
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  StrViews.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "CharUtil.h"
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Pipeable range adaptor. range | adaptor calls the wrapped function on the range, and
+// adaptor | adaptor composes the two into a new adaptor.
+
+template< typename Fn >
+class RangeAdaptor
+{
+public:
+
+  constexpr explicit RangeAdaptor( Fn fn ) :
+    fn_( fn )
+  {
+  }
+
+  template< std::ranges::viewable_range R >
+  constexpr auto operator()( R&& r ) const
+  {
+    return fn_( std::forward<R>( r ) );
+  }
+
+  template< std::ranges::viewable_range R >
+  friend constexpr auto operator|( R&& r, const RangeAdaptor& adaptor )
+  {
+    return adaptor( std::forward<R>( r ) );
+  }
+
+  template< typename Next >
+  friend constexpr auto operator|( const RangeAdaptor& first, const RangeAdaptor<Next>& next )
+  {
+    return RangeAdaptor< decltype( Compose( first, next ) ) >( Compose( first, next ) );
+  }
+
+private:
+
+  template< typename Next >
+  static constexpr auto Compose( const RangeAdaptor& first, const RangeAdaptor<Next>& next )
+  {
+    return [first, next]( auto&& r ) { return next( first( std::forward<decltype( r )>( r ) ) ); };
+  }
+
+private:
+
+  Fn fn_;
+
+}; // RangeAdaptor
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Lazy view of a character range with XML special characters expanded to their markup, matching
+// StrUtilT::GetXmlSafe. Each element of the underlying range is read once.
+
+template< std::ranges::view V >
+  requires std::ranges::forward_range<V>
+class XmlEscapeViewT : public std::ranges::view_interface< XmlEscapeViewT<V> >
+{
+private:
+
+  using C = std::ranges::range_value_t< V >;
+  using viewT = std::basic_string_view< C >;
+
+public:
+
+  class Iterator
+  {
+  public:
+
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type       = C;
+    using difference_type  = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    Iterator( std::ranges::iterator_t<V> current, std::ranges::sentinel_t<V> end ) :
+      current_( std::move( current ) ),
+      end_( std::move( end ) )
+    {
+      Load();
+    }
+
+    C operator*() const
+    {
+      return code_.empty() ? c_ : code_[ pos_ ];
+    }
+
+    Iterator& operator++()
+    {
+      // An unescaped character has an empty code and occupies a single position
+      if( ++pos_ >= code_.size() )
+      {
+        ++current_;
+        pos_ = 0;
+        Load();
+      }
+      return *this;
+    }
+
+    Iterator operator++( int )
+    {
+      auto prev = *this;
+      ++*this;
+      return prev;
+    }
+
+    friend bool operator==( const Iterator& lhs, const Iterator& rhs )
+    {
+      return lhs.current_ == rhs.current_ && lhs.pos_ == rhs.pos_;
+    }
+
+    friend bool operator==( const Iterator& i, std::default_sentinel_t )
+    {
+      return i.current_ == i.end_;
+    }
+
+  private:
+
+    void Load()
+    {
+      if( current_ == end_ )
+        return;
+      c_ = *current_;
+      code_ = StrUtilT<C>::GetXmlCode( c_ );
+    }
+
+  private:
+
+    std::ranges::iterator_t<V> current_ = {};
+    std::ranges::sentinel_t<V> end_ = {};
+    viewT  code_;     // markup for c_, or empty if c_ is not escaped
+    size_t pos_ = 0;  // position within code_
+    C      c_ = C( 0 );
+
+  }; // Iterator
+
+public:
+
+  XmlEscapeViewT() requires std::default_initializable<V> = default;
+
+  constexpr explicit XmlEscapeViewT( V base ) :
+    base_( std::move( base ) )
+  {
+  }
+
+  Iterator begin() { return Iterator( std::ranges::begin( base_ ), std::ranges::end( base_ ) ); }
+  std::default_sentinel_t end() { return std::default_sentinel; }
+
+private:
+
+  V base_ = V();
+
+}; // XmlEscapeViewT
+
+template< typename R >
+XmlEscapeViewT( R&& ) -> XmlEscapeViewT< std::views::all_t<R> >;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Lazy, composable versions of the StrUtilT transforms. A chain of adaptors is one pass over the
+// input, and to_string materializes the result with a single allocation:
+//
+//    auto name = fileName | views::trimmed( " " ) | views::lower | views::good_file_char
+//                         | views::to_string;
+//
+// Character arrays such as string literals are treated as strings, without the terminating null.
+
+namespace views
+{
+
+template< typename R >
+constexpr auto All( R&& r )
+{
+  if constexpr( std::is_array_v< std::remove_reference_t<R> > )
+    return std::basic_string_view< std::ranges::range_value_t<R> >( r );
+  else
+    return std::views::all( std::forward<R>( r ) );
+}
+
+template< typename R >
+using CharT = std::ranges::range_value_t< decltype( All( std::declval<R>() ) ) >;
+
+inline constexpr RangeAdaptor lower( []< typename R >( R&& r )
+  {
+    return std::views::transform( All( std::forward<R>( r ) ), CharUtilT< CharT<R> >::ToLower );
+  } );
+
+inline constexpr RangeAdaptor upper( []< typename R >( R&& r )
+  {
+    return std::views::transform( All( std::forward<R>( r ) ), CharUtilT< CharT<R> >::ToUpper );
+  } );
+
+// Equivalent to ConvertWildcards::No
+inline constexpr RangeAdaptor good_file_char( []< typename R >( R&& r )
+  {
+    return std::views::transform( All( std::forward<R>( r ) ), CharUtilT< CharT<R> >::ToGoodFileChar );
+  } );
+
+// Equivalent to ConvertWildcards::Yes
+inline constexpr RangeAdaptor good_file_char_wildcards( []< typename R >( R&& r )
+  {
+    return std::views::transform( All( std::forward<R>( r ) ), CharUtilT< CharT<R> >::ToGoodFileCharConvertWildcards );
+  } );
+
+// remove_wildcards | good_file_char is equivalent to ConvertWildcards::Remove
+inline constexpr RangeAdaptor remove_wildcards( []< typename R >( R&& r )
+  {
+    return std::views::filter( All( std::forward<R>( r ) ),
+                               []( CharT<R> c ) { return !CharUtilT< CharT<R> >::IsWildcardFileChar( c ); } );
+  } );
+
+inline constexpr RangeAdaptor xml_escaped( []< typename R >( R&& r )
+  {
+    return XmlEscapeViewT( All( std::forward<R>( r ) ) );
+  } );
+
+// Trims a contiguous string without copying; the result refers to the original characters. The
+// charset is copied into the adaptor, so only the input must outlive the result.
+template< typename S >
+constexpr auto trimmed( S trimCharset )
+{
+  return RangeAdaptor( [trimCharset]< typename R >( R&& r )
+    requires std::ranges::contiguous_range<R> && std::ranges::borrowed_range<R>
+    {
+      using viewT = std::basic_string_view< CharT<R> >;
+      return StrUtilT< CharT<R> >::GetTrimmedView( viewT( All( std::forward<R>( r ) ) ), viewT( trimCharset ) );
+    } );
+}
+
+// Materialize any character range; forward ranges are measured first so the string allocates once
+inline constexpr RangeAdaptor to_string( []< typename R >( R&& r )
+  {
+    auto chars = All( std::forward<R>( r ) );
+    std::basic_string< CharT<R> > str;
+    if constexpr( std::ranges::sized_range<decltype( chars )> )
+      str.reserve( std::ranges::size( chars ) );
+    else if constexpr( std::ranges::forward_range<decltype( chars )> )
+      str.reserve( static_cast<size_t>( std::ranges::distance( chars ) ) );
+    for( auto c : chars )
+      str.push_back( c );
+    return str;
+  } );
+
+} // views
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,7 +13,19 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "CharUtil.h"
+#include "ConcurrentStrList.h"
+#include "ParallelStrUtil.h"
+#include "StaticStrSet.h"
+#include "StrBloomFilter.h"
+#include "StrListFile.h"
+#include "StrListView.h"
+#include "StrPipeline.h"
+#include "StrPool.h"
+#include "StrTrie.h"
 #include "StrUtil.h"
+#include "StrViews.h"
+#include "VersionedStrList.h"
+#include "XmlEscape.h"
 
 // Currently all elements of the String library are in header files
 
@@ -13,8 +13,28 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "CharUtil.h"
+#include "ConcurrentStrList.h"
+#include "ParallelStrUtil.h"
+#include "StaticStrSet.h"
+#include "StrBloomFilter.h"
+#include "StrListFile.h"
+#include "StrListView.h"
+#include "StrPipeline.h"
+#include "StrPool.h"
+#include "StrTrie.h"
 #include "StrUtil.h"
+#include "StrViews.h"
+#include "VersionedStrList.h"
+#include "XmlEscape.h"
+#include <atomic>
 #include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace PKIsensee;
 
@@ -165,6 +185,7 @@ void TestString()
   test( StrUtil::GetDurationStr( 123456789 ) == "1428d:21h:33m:09s" );
   test( StrUtil::GetDurationStr( 123456 ) == "34h:17m:36s" );
   test( StrUtil::GetDurationStr( 1 ) == "00m:01s" );
+  test( StrUtil::GetDurationStr( 1, 0 ) == "0d:00h:00m:01s" );
 }
 
 void TestStrList()
@@ -192,6 +213,1012 @@ void TestStrList()
   test( a == b );
   b.front() = "zzz";
   test( a != b );
+
+  StrList c;
+  test( c.Join( ", " ).empty() );
+  c.push_back( "a<b" );
+  c.push_back( "" );
+  c.push_back( "cd" );
+  test( c.GetJoinedCharCount( 2 ) == 9 );
+  test( c.Join( ", " ) == "a<b, , cd" );
+  std::string joined( "x=" );
+  c.JoinTo( joined, "|" );
+  test( joined == "x=a<b||cd" );
+  auto xmlSafe = []( std::string& out, const std::string& str ) { out += StrUtil::GetXmlSafe( str ); };
+  test( c.Join( "&", xmlSafe ) == "a&lt;b&&cd" );
+  char buffer[ 16 ];
+  test( !c.JoinTo( buffer, 5, "," ) );
+  test( c.JoinTo( buffer, sizeof( buffer ), "," ) == 7 );
+  test( std::string( buffer, 7 ) == "a<b,,cd" );
+  test( StrList().JoinTo( buffer, 0, "," ) == 0u );
+}
+
+void TestSplit()
+{
+  auto parts = StrUtil::GetSplit( "a,,bc,", ',' );
+  test( parts.size() == 4 );
+  test( parts.front() == "a" );
+  test( parts.find( "" ) );
+  test( parts.find( "bc" ) );
+  test( StrUtil::GetSplit( "", ',' ).size() == 1 );
+  test( StrUtil::GetSplit( "", ',', StrUtil::EmptyParts::Skip ).empty() );
+  test( StrUtil::GetSplit( "a,,bc,", ',', StrUtil::EmptyParts::Skip ).size() == 2 );
+  test( StrUtil::GetSplit( "abc", "" ).front() == "abc" );
+
+  size_t count = 0;
+  for( auto part : StrUtil::Split( "one::two::three", "::" ) )
+  {
+    test( part.size() >= 3 );
+    ++count;
+  }
+  test( count == 3 );
+
+  auto words = StrUtilW::GetSplit( L"  the quick\tfox ", CharUtilW::IsWhitespace, StrUtilW::EmptyParts::Skip );
+  test( words.size() == 3 );
+  test( words.front() == L"the" );
+  test( words.find( L"fox" ) );
+
+  // Iterators remain valid after the range that produced them is gone
+  auto it = [] { return StrUtil::Split( "x;y", ';' ); }().begin();
+  test( *it == "x" && *++it == "y" );
+  char sep = '|';
+  auto byLambda = StrUtil::Split( "p|q", [sep]( char c ) { return c == sep; } );
+  static_assert( std::ranges::forward_range<decltype( byLambda )> );
+  auto first = byLambda.begin();
+  first = std::ranges::next( byLambda.begin() );
+  test( *first == "q" );
+}
+
+void TestStrListView()
+{
+  auto path = std::filesystem::temp_directory_path() / "TestStrListView.txt";
+  {
+    std::ofstream file( path, std::ios::binary );
+    file << "alpha\r\nbeta\n\ngamma\n";
+  }
+
+  StrListView view;
+  test( view.LoadLines( path ) );
+  test( view.size() == 4 );
+  test( view.front() == "alpha" );
+  test( view.find( "gamma" ) );
+  test( !view.find( "delta" ) );
+  test( view.ContainsEmptyStrings() );
+  test( view.GetCharCount() == 14 );
+
+  StrList list = view.GetStrList();
+  test( list.size() == 4 );
+  test( list.find( "beta" ) );
+  StrListView listView( list );
+  test( listView.size() == 4 );
+  test( listView.find( "alpha" ) );
+
+  view.clear();
+  std::filesystem::remove( path );
+  test( !view.LoadLines( path ) );
+}
+
+void TestStrListFile()
+{
+  auto path = std::filesystem::temp_directory_path() / "TestStrListFile.bin";
+  StrList list;
+  list.push_back( "alpha" );
+  list.push_back( "" );
+  list.push_back( "gamma" );
+  test( StrListFile::Write( list, path ) );
+
+  StrListFile file;
+  test( file.Open( path, StrListFile::Checksum::Yes ) );
+  test( file.HasHashIndex() );
+  test( file.size() == 3 );
+  test( file.GetCharCount() == 10 );
+  test( file[ 0 ] == "alpha" );
+  test( file[ 1 ].empty() );
+  test( file.find( "gamma" ) );
+  test( file.find( "" ) );
+  test( !file.find( "beta" ) );
+  test( file.GetStrList() == list );
+  test( !StrListFileW().Open( path ) );
+  file.Close();
+
+  // Corrupt images are rejected even without the checksum
+  std::vector<char> image( std::filesystem::file_size( path ) );
+  std::ifstream( path, std::ios::binary ).read( image.data(), std::streamsize( image.size() ) );
+  auto openCorrupted = [&]( size_t offset, auto value )
+    {
+      auto corrupted = image;
+      std::memcpy( corrupted.data() + offset, &value, sizeof( value ) );
+      std::ofstream( path, std::ios::binary ).write( corrupted.data(), std::streamsize( corrupted.size() ) );
+      return StrListFile().Open( path );
+    };
+  const size_t offsetsStart = sizeof( StrListFileHeader );
+  const size_t bucketsStart = image.size() - ( 8 * sizeof( uint32_t ) );
+  test( openCorrupted( offsetsStart, uint64_t( 0 ) ) );
+  test( !openCorrupted( offsetsStart, uint64_t( 9 ) ) );
+  test( !openCorrupted( offsetsStart + sizeof( uint64_t ), uint64_t( 11 ) ) );
+  test( !openCorrupted( bucketsStart, uint32_t( 99 ) ) );
+  std::array<uint32_t, 8> fullBuckets;
+  fullBuckets.fill( 1 );
+  test( !openCorrupted( bucketsStart, fullBuckets ) );
+
+  StrListW wideList;
+  wideList.push_back( L"wide" );
+  test( StrListFileW::Write( wideList, path, StrListFileW::HashIndex::No, StrListFileW::Checksum::No ) );
+  StrListFileW wideFile;
+  test( wideFile.Open( path ) );
+  test( !wideFile.HasHashIndex() );
+  test( wideFile.find( L"wide" ) );
+  test( !wideFile.Open( path, StrListFileW::Checksum::Yes ) );
+  wideFile.Close();
+  std::filesystem::remove( path );
+}
+
+void TestConcurrentStrList()
+{
+  ConcurrentStrList concurrent;
+  const size_t kThreads = 4;
+  const size_t kStrsPerThread = 1000;
+  {
+    std::vector<std::jthread> producers;
+    for( size_t t = 0; t < kThreads; ++t )
+      producers.emplace_back( [&concurrent, t]()
+        {
+          for( size_t i = 0; i < kStrsPerThread; ++i )
+            concurrent.push_back( std::to_string( t * kStrsPerThread + i ) );
+        } );
+  }
+  test( concurrent.size() == kThreads * kStrsPerThread );
+
+  StrList list;
+  list.push_back( "first" );
+  concurrent.Seal( list );
+  test( concurrent.size() == 0 );
+  test( list.size() == kThreads * kStrsPerThread + 1 );
+  test( list.front() == "first" );
+  test( list.find( "0" ) );
+  test( list.find( "3999" ) );
+  test( !list.find( "4000" ) );
+
+  concurrent.push_back( "again" );
+  test( concurrent.Seal().front() == "again" );
+}
+
+void TestVersionedStrList()
+{
+  StrList initial;
+  initial.push_back( "v0" );
+  VersionedStrList versioned( initial );
+  test( versioned.GetVersion() == 0 );
+  {
+    auto snapshot = versioned.GetSnapshot();
+    test( snapshot->find( "v0" ) );
+  }
+
+  // Each published list holds two copies of the same string, so a reader that ever sees
+  // mismatched strings has observed a torn or reclaimed version
+  std::atomic<bool> done = false;
+  std::atomic<bool> consistent = true;
+  {
+    std::vector<std::jthread> readers;
+    for( int t = 0; t < 4; ++t )
+      readers.emplace_back( [&versioned, &done, &consistent]()
+        {
+          while( !done )
+          {
+            auto snapshot = versioned.GetSnapshot();
+            if( snapshot->size() == 2 && *snapshot->begin() != *std::next( snapshot->begin() ) )
+              consistent = false;
+          }
+        } );
+
+    for( int v = 1; v <= 100; ++v )
+    {
+      StrList next;
+      next.push_back( "v" + std::to_string( v ) );
+      next.push_back( "v" + std::to_string( v ) );
+      versioned.Publish( next );
+    }
+    done = true;
+  }
+  test( consistent );
+  test( versioned.GetVersion() == 100 );
+  test( versioned.GetSnapshot()->find( "v100" ) );
+}
+
+void TestStrPool()
+{
+  StrPool pool;
+  auto host = pool.Intern( "example.com" );
+  test( host == "example.com" );
+  test( pool.Intern( std::string( "example.com" ) ).data() == host.data() );
+  test( pool.Find( "example.com" ).data() == host.data() );
+  test( pool.Find( "example.org" ).data() == nullptr );
+  test( pool.size() == 1 );
+  test( pool.GetMemoryUsed() > 0 );
+
+  StrList list;
+  list.push_back( "a" );
+  list.push_back( "b" );
+  list.push_back( "a" );
+  InternedStrList interned( pool, list );
+  test( interned.size() == 3 );
+  test( interned.front().data() == std::prev( interned.end() )->data() );
+  test( pool.size() == 3 );
+  test( interned.find( "b" ) );
+  test( !interned.find( "example.org" ) );
+  test( !interned.find( "example.com" ) );
+  test( interned.GetCharCount() == 3 );
+  test( interned.GetStrList() == list );
+
+  InternedStrList same( pool, list );
+  test( interned == same );
+  same.push_back( "" );
+  test( same.ContainsEmptyStrings() );
+  test( interned != same );
+
+  StrPool otherPool;
+  InternedStrList other( otherPool, list );
+  test( interned == other );
+}
+
+void TestStaticStrSet()
+{
+  constexpr auto kKeywords = MakeStaticStrSet( "auto", "break", "case", "char", "const", "continue",
+    "default", "do", "double", "else", "enum", "extern", "float", "for", "goto", "if", "int",
+    "long", "register", "return", "short", "signed", "sizeof", "static", "struct", "switch",
+    "typedef", "union", "unsigned", "void", "volatile", "while" );
+  static_assert( kKeywords.find( "while" ) );
+  static_assert( !kKeywords.contains( "whilst" ) );
+  static_assert( kKeywords.GetIndex( "auto" ) == 0 );
+
+  test( kKeywords.size() == 32 );
+  for( auto keyword : kKeywords )
+    test( kKeywords.find( keyword ) );
+  test( !kKeywords.find( "" ) );
+  test( !kKeywords.find( std::string( "Return" ) ) );
+  test( kKeywords.GetIndex( "void" ) == 29 );
+
+  constexpr auto kWide = MakeStaticStrSet( L"con", L"prn", L"aux", L"nul" );
+  test( kWide.contains( L"nul" ) );
+  test( !kWide.contains( L"com1" ) );
+}
+
+void TestBloomFilter()
+{
+  StrBloomFilter filter( 1000, 0.01 );
+  test( filter.GetMemoryUsed() == 1216 ); // 9585 bits rounded up to 19 blocks
+  test( filter.GetHashCount() == 7 );
+  for( int i = 0; i < 1000; ++i )
+    filter.Add( "in" + std::to_string( i ) );
+  for( int i = 0; i < 1000; ++i )
+    test( filter.MayContain( "in" + std::to_string( i ) ) );
+  int falsePositives = 0;
+  for( int i = 0; i < 10000; ++i )
+    falsePositives += filter.MayContain( "out" + std::to_string( i ) ) ? 1 : 0;
+  test( falsePositives < 300 );
+  filter.clear();
+  test( !filter.MayContain( "in0" ) );
+
+  StrList deny;
+  deny.push_back( "evil.com" );
+  deny.push_back( "" );
+  FilteredStrList filtered( deny );
+  static_assert( !std::is_convertible_v<StrList, FilteredStrList> );
+  test( filtered.find( "evil.com" ) );
+  test( filtered.find( "" ) );
+  test( !filtered.find( "good.com" ) );
+  filtered.push_back( "bad.com" );
+  test( filtered.find( "bad.com" ) );
+  test( filtered.size() == 3 );
+  test( filtered.GetCharCount() == 15 );
+
+  FilteredStrListW wide( 10 );
+  wide.push_back( L"x" );
+  test( wide.find( L"x" ) );
+  test( !wide.find( L"y" ) );
+
+  // Growing well past the expected count keeps the false positive rate near its target
+  FilteredStrList grown( 10 );
+  for( int i = 0; i < 1000; ++i )
+    grown.push_back( "in" + std::to_string( i ) );
+  test( grown.GetFilter().GetMemoryUsed() >= filter.GetMemoryUsed() );
+  test( grown.find( "in0" ) && grown.find( "in999" ) );
+  falsePositives = 0;
+  for( int i = 0; i < 10000; ++i )
+    falsePositives += grown.GetFilter().MayContain( "out" + std::to_string( i ) ) ? 1 : 0;
+  test( falsePositives < 300 );
+}
+
+void TestStrTrie()
+{
+  StrList rules;
+  rules.push_back( "/api" );
+  rules.push_back( "/api/v1" );
+  rules.push_back( "/api/v1/users" );
+  rules.push_back( "/app" );
+  rules.push_back( "/api" );
+  StrTrie trie( rules );
+  test( trie.size() == 4 );
+  test( trie.find( "/api/v1" ) );
+  test( !trie.find( "/api/v" ) );
+  test( !trie.find( "/ap" ) );
+  test( trie.GetLongestPrefix( "/api/v1/users/42" ) == 13 );
+  test( trie.GetLongestPrefix( "/api/v2" ) == 4 );
+  test( trie.GetLongestPrefix( "/images" ) == StrTrie::npos );
+  auto prefixes = trie.GetAllPrefixes( "/api/v1/groups" );
+  test( prefixes.size() == 2 );
+  test( prefixes.front() == "/api" );
+  test( prefixes.back() == "/api/v1" );
+  test( trie.StartsWith( "/ap" ) );
+  test( trie.StartsWith( "/api/v1/u" ) );
+  test( !trie.StartsWith( "/api/v2" ) );
+  test( trie.GetMemoryUsed() > 0 );
+
+  StrTrie empty;
+  test( empty.empty() );
+  test( !empty.find( "" ) );
+  test( !empty.StartsWith( "" ) );
+
+  StrListW wide;
+  wide.push_back( L"" );
+  wide.push_back( L"C:\\" );
+  StrTrieW wideTrie( wide );
+  test( wideTrie.find( L"" ) );
+  test( wideTrie.GetLongestPrefix( L"D:\\" ) == 0 );
+  test( wideTrie.GetLongestPrefix( L"C:\\Windows" ) == 3 );
+}
+
+void TestPmr()
+{
+  // Everything below must come from the arena; the upstream and default resources throw if
+  // they're needed
+  char buffer[ 4096 ];
+  std::pmr::monotonic_buffer_resource arena( buffer, sizeof( buffer ), std::pmr::null_memory_resource() );
+  auto prevDefault = std::pmr::set_default_resource( std::pmr::null_memory_resource() );
+
+  test( StrUtil::GetXmlSafe( "a&b", &arena ) == "a&amp;b" );
+  test( StrUtil::GetTrimmed( "  abc  ", " ", &arena ) == "abc" );
+  test( StrUtil::GetTrimmedLeading( "  abc  ", " ", &arena ) == "abc  " );
+  test( StrUtil::GetTrimmedTrailing( "  abc  ", " ", &arena ) == "  abc" );
+  test( StrUtil::GetGoodFileName( "<jlo?>.bad", StrUtil::ConvertWildcards::Remove, &arena ) == "(jlo).bad" );
+  test( StrUtilW::GetUpper( L"abc", &arena ) == L"ABC" );
+  test( StrUtilW::GetLower( L"ABC", &arena ) == L"abc" );
+  test( StrUtil::GetUpper( "abc", &arena ).get_allocator().resource() == &arena );
+
+  pmr::StrList list( &arena );
+  list.push_back( "a fairly long string that defeats the small string optimization" );
+  list.push_back( "b" );
+  test( list.find( "b" ) );
+  test( list.front().get_allocator().resource() == &arena );
+  test( list.Join( "," ).get_allocator().resource() == &arena );
+  test( list.GetJoinedCharCount( 1 ) == list.Join( "," ).size() );
+  pmr::StrList copy( list.begin(), list.end(), &arena );
+  test( copy == list );
+  copy.push_back( std::string_view( "another string that is too long to be stored inline" ) );
+  copy.emplace_back( 3, 'c' );
+  test( copy.size() == 4 );
+  test( StrUtil::GetDurationStr( 65, 0, &arena ) == "0d:00h:01m:05s" );
+  std::pmr::set_default_resource( prevDefault );
+}
+
+void TestAppend()
+{
+  std::string out( "x:" );
+  StrUtil::AppendXmlSafe( out, "<a & 'b'>" );
+  test( out == "x:&lt;a &amp; &apos;b&apos;&gt;" );
+  test( out.substr( 2 ) == StrUtil::GetXmlSafe( "<a & 'b'>" ) );
+
+  std::wstring wide;
+  StrUtilW::AppendXmlSafe( wide, L"\"q\"" );
+  test( wide == StrUtilW::GetXmlSafe( L"\"q\"" ) );
+
+  char buffer[ 64 ] = {};
+  auto end = StrUtil::CopyXmlSafe( "1<2", buffer );
+  test( std::string_view( buffer, end ) == "1&lt;2" );
+
+  std::string clean( "nothing to escape" );
+  StrUtil::ToXmlSafe( clean );
+  test( clean == "nothing to escape" );
+
+  out.clear();
+  StrUtil::AppendTrimmed( out, "  abc  ", " " );
+  StrUtil::AppendTrimmedLeading( out, "  abc  ", " " );
+  StrUtil::AppendTrimmedTrailing( out, "  abc  ", " " );
+  test( out == "abcabc    abc" );
+  end = StrUtil::CopyTrimmed( "    ", " ", buffer );
+  test( end == buffer );
+
+  out.clear();
+  StrUtil::AppendGoodFileName( out, "<jlo?>.bad", StrUtil::ConvertWildcards::Remove );
+  test( out == StrUtil::GetGoodFileName( "<jlo?>.bad", StrUtil::ConvertWildcards::Remove ) );
+  end = StrUtil::CopyGoodFileName( "a*b", StrUtil::ConvertWildcards::Yes, buffer );
+  test( std::string_view( buffer, end ) == StrUtil::GetGoodFileName( "a*b", StrUtil::ConvertWildcards::Yes ) );
+
+  out = "A";
+  StrUtil::AppendLower( out, "BC" );
+  StrUtil::AppendUpper( out, "de" );
+  test( out == "AbcDE" );
+  end = StrUtil::CopyUpper( "xyz", buffer );
+  test( std::string_view( buffer, end ) == "XYZ" );
+
+  out = "took ";
+  StrUtil::AppendDurationStr( out, 3 * 60 + 5 );
+  test( out == "took " + StrUtil::GetDurationStr( 3 * 60 + 5 ) );
+}
+
+void TestViews()
+{
+  using namespace std::literals;
+  test( ( "MiXeD"sv | views::lower | views::to_string ) == "mixed" );
+  test( ( L"MiXeD"sv | views::upper | views::to_string ) == L"MIXED" );
+  test( ( "a<b" | views::to_string ) == "a<b" );
+
+  std::string xml( "<a & 'b'>" );
+  test( ( xml | views::xml_escaped | views::to_string ) == StrUtil::GetXmlSafe( xml ) );
+  test( ( std::string( "\"q\"" ) | views::xml_escaped | views::to_string ) == "&quot;q&quot;" );
+  test( ( ""sv | views::xml_escaped | views::to_string ).empty() );
+  test( std::ranges::distance( "&&"sv | views::xml_escaped ) == 10 );
+
+  std::string fileName( "<jlo?>.bad" );
+  test( ( fileName | views::good_file_char | views::to_string ) ==
+        StrUtil::GetGoodFileName( fileName, StrUtil::ConvertWildcards::No ) );
+  test( ( fileName | views::good_file_char_wildcards | views::to_string ) ==
+        StrUtil::GetGoodFileName( fileName, StrUtil::ConvertWildcards::Yes ) );
+  test( ( fileName | views::remove_wildcards | views::good_file_char | views::to_string ) ==
+        StrUtil::GetGoodFileName( fileName, StrUtil::ConvertWildcards::Remove ) );
+
+  // Composed adaptors are applied in one pass
+  auto normalize = views::trimmed( " " ) | views::lower | views::good_file_char | views::xml_escaped;
+  std::string padded( "  Tom & <Jerry>  " );
+  auto expected = StrUtil::GetXmlSafe( StrUtil::GetGoodFileName( StrUtil::GetLower( StrUtil::GetTrimmed( padded, " " ) ),
+                                                                 StrUtil::ConvertWildcards::No ) );
+  test( ( padded | normalize | views::to_string ) == expected );
+  test( ( padded | views::trimmed( " " ) ).data() == padded.data() + 2 );
+}
+
+void TestPipeline()
+{
+  using NormalizeName = Pipeline< Stage::Trim, Stage::Lower, Stage::GoodFileName >;
+  std::string raw( " \t My <Song>: Take 2?\r\n" );
+  auto expected = StrUtil::GetGoodFileName( StrUtil::GetLower( StrUtil::GetTrimmed( raw, " \t\r\n" ) ),
+                                            StrUtil::ConvertWildcards::No );
+  test( NormalizeName::Get( raw ) == expected );
+  test( NormalizeName::Get( L" ABC " ) == L"abc" );
+  test( NormalizeName::Get( "   " ).empty() );
+  test( NormalizeName::Get( "" ).empty() );
+
+  using Remove = Pipeline< Stage::RemoveWildcards, Stage::GoodFileName >;
+  test( Remove::Get( "<jlo?>.bad" ) == StrUtil::GetGoodFileName( "<jlo?>.bad", StrUtil::ConvertWildcards::Remove ) );
+
+  using Escape = Pipeline< Stage::Upper, Stage::XmlSafe >;
+  std::string out( "x=" );
+  Escape::Append( out, "a<b & 'c'" );
+  test( out == "x=" + StrUtil::GetXmlSafe( "A<B & 'C'" ) );
+
+  // A trim after other stages sees their output: RemoveWildcards drops '*' and '?', which are then
+  // invisible to the trim, so the ' ' and '.' beyond them are trimmed too
+  using Late = Pipeline< Stage::RemoveWildcards, Stage::GoodFileNameConvertWildcards, Stage::TrimChars<' ', '.'> >;
+  test( Late::Get( "*. ab ?." ) == "ab" );
+  using Twice = Pipeline< Stage::TrimChars<'x'>, Stage::Upper, Stage::TrimChars<'Y'> >;
+  test( Twice::Get( "xyaybyx" ) == "AYB" );
+}
+
+void TestParallel()
+{
+  // Enough text for many chunks
+  StrList strList;
+  for( size_t i = 0; i < 20000; ++i )
+    strList.push_back( "  Item <" + std::to_string( i ) + "> & Co: \"Quoted?\"  " );
+  strList.push_back( "" );
+
+  auto expected = strList;
+  for( auto& str : expected )
+  {
+    StrUtil::ToTrimmed( str, " " );
+    StrUtil::ToLower( str );
+    StrUtil::ToGoodFileName( str, StrUtil::ConvertWildcards::Remove );
+  }
+  ParallelStrUtil::ToTrimmed( strList, " ", 4 );
+  ParallelStrUtil::ToLower( strList, 4 );
+  ParallelStrUtil::ToGoodFileName( strList, StrUtil::ConvertWildcards::Remove );
+  test( strList == expected );
+
+  for( auto& str : expected )
+    StrUtil::ToXmlSafe( str );
+  ParallelStrUtil::ToXmlSafe( strList, 3 );
+  test( strList == expected );
+
+  std::atomic<size_t> visited = 0;
+  ParallelStrUtil::Transform( strList, [&visited]( std::string& ) { ++visited; } );
+  test( visited == strList.size() );
+
+  // An exception on any thread reaches the caller after all threads have stopped
+  bool isThrown = false;
+  try
+  {
+    ParallelStrUtil::Transform( strList, []( std::string& str )
+      {
+        if( str.starts_with( "item (19999)" ) )
+          throw std::runtime_error( "bad string" );
+      }, 4 );
+  }
+  catch( const std::runtime_error& )
+  {
+    isThrown = true;
+  }
+  test( isThrown );
+
+  StrListW small;
+  small.push_back( L"ABC" );
+  ParallelStrUtilW::ToLower( small );
+  test( small.front() == L"abc" );
+
+  StrList empty;
+  ParallelStrUtil::ToUpper( empty );
+  test( empty.empty() );
+
+  // Large buffer escaped in many chunks, with markup at chunk boundaries
+  std::string doc;
+  for( size_t i = 0; i < 100000; ++i )
+    doc += ( i % 7 == 0 ) ? "<tag attr='x'>&amp;</tag>" : "plain text ";
+  test( ParallelStrUtil::GetXmlSafe( doc, 4 ) == StrUtil::GetXmlSafe( doc ) );
+  test( ParallelStrUtil::GetXmlSafe( std::string( 40000, '&' ), 3 ) == StrUtil::GetXmlSafe( std::string( 40000, '&' ) ) );
+  test( ParallelStrUtil::GetXmlSafe( "a<b" ) == "a&lt;b" );
+  test( ParallelStrUtil::GetXmlSafe( "" ).empty() );
+  test( ParallelStrUtilW::GetXmlSafe( L"\"w\"" ) == StrUtilW::GetXmlSafe( L"\"w\"" ) );
+}
+
+void TestXmlEscapeWriter()
+{
+  std::string input;
+  for( size_t i = 0; i < 2000; ++i )
+    input += "<a href='x'>Tom & \"Jerry\"</a>";
+  input += std::string( 10000, 'z' ); // larger than the buffer
+  auto expected = "<doc>" + StrUtil::GetXmlSafe( input ) + "</doc>";
+
+  std::ostringstream stream;
+  {
+    XmlEscapeWriter< OStreamSinkT<char> > writer( OStreamSinkT<char>{ &stream } );
+    test( writer.WriteRaw( "<doc>" ) );
+    test( writer.Write( input ) );
+    test( writer.WriteRaw( "</doc>" ) );
+  }
+  test( stream.str() == expected );
+
+  // User callback; output arrives in pieces no larger than the buffer unless a run is larger
+  std::wstring wide;
+  size_t calls = 0;
+  auto append = [&wide, &calls]( const wchar_t* data, size_t count ) { wide.append( data, count ); ++calls; return true; };
+  XmlEscapeWriterW< decltype( append ) > wideWriter( append );
+  wideWriter.Write( L"1 < 2" );
+  test( wide.empty() );
+  test( wideWriter.Flush() );
+  test( wide == L"1 &lt; 2" && calls == 1 );
+
+  auto path = std::filesystem::temp_directory_path() / "TestXmlEscapeWriter.xml";
+  FILE* file = nullptr;
+#if defined( _WIN32 )
+  test( _wfopen_s( &file, path.c_str(), L"wb" ) == 0 );
+#else
+  file = fopen( path.c_str(), "wb" );
+#endif
+  test( file != nullptr );
+  {
+    XmlEscapeWriter<FileSink> writer( FileSink{ file } );
+    writer.Write( input );
+  }
+  fclose( file );
+  std::ifstream in( path, std::ios::binary );
+  std::string fromFile( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+  in.close();
+  test( fromFile == StrUtil::GetXmlSafe( input ) );
+  std::filesystem::remove( path );
+
+  // A failed sink stops all further output
+  auto fail = []( const char*, size_t ) { return false; };
+  XmlEscapeWriter< decltype( fail ) > failWriter( fail );
+  failWriter.Write( "a&b" );
+  test( !failWriter.Flush() );
+  test( !failWriter.Write( "c" ) );
+}
+
+void TestXmlSegments()
+{
+  std::string input( "Mostly clean text with one & and <two> specials" );
+  std::vector<std::string_view> segments;
+  XmlEscape::GetSegments( input, segments );
+  test( segments.size() == 7 );
+  test( segments[ 0 ].data() == input.data() ); // refers to the input, not a copy
+
+  std::string joined;
+  for( auto segment : segments )
+    joined += segment;
+  test( joined == StrUtil::GetXmlSafe( input ) );
+
+  segments.clear();
+  XmlEscape::GetSegments( "", segments );
+  test( segments.empty() );
+
+  // More segments than one writev batch
+  std::string many;
+  for( size_t i = 0; i < 500; ++i )
+    many += "x&";
+  segments.clear();
+  XmlEscape::GetSegments( many, segments );
+  segments.push_back( {} );
+
+  auto path = std::filesystem::temp_directory_path() / "TestXmlSegments.xml";
+  FILE* file = nullptr;
+#if defined( _WIN32 )
+  test( _wfopen_s( &file, path.c_str(), L"wb" ) == 0 );
+  int fd = _fileno( file );
+#else
+  file = fopen( path.c_str(), "wb" );
+  int fd = fileno( file );
+#endif
+  test( XmlEscape::WriteSegments( fd, segments ) );
+  fclose( file );
+  std::ifstream in( path, std::ios::binary );
+  std::string fromFile( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+  in.close();
+  test( fromFile == StrUtil::GetXmlSafe( many ) );
+  std::filesystem::remove( path );
+}
+
+void TestXmlBounded()
+{
+  std::string input( "<item name=\"Tom & Jerry\">It's 'quoted'</item>" );
+  auto expected = StrUtil::GetXmlSafe( input );
+  test( XmlEscape::kMaxCodeLength == 6 );
+
+  // Fill small frames; every frame must be complete markup
+  for( size_t frameSize = XmlEscape::kMaxCodeLength; frameSize <= 16; ++frameSize )
+  {
+    std::string output;
+    std::vector<char> frame( frameSize );
+    XmlEscape::State state;
+    size_t consumed = 0;
+    for( ;; )
+    {
+      auto result = XmlEscape::EscapeBounded( input, frame, state );
+      test( result.produced <= frameSize );
+      test( result.consumed > 0 );
+      std::string_view piece( frame.data(), result.produced );
+      test( StrUtil::GetXmlSafe( input.substr( consumed, result.consumed ) ) == piece );
+      output += piece;
+      consumed += result.consumed;
+      if( result.isDone )
+        break;
+    }
+    test( output == expected );
+    test( consumed == input.size() );
+  }
+
+  // Too small for the next markup: no progress, state unchanged
+  char tiny[ 3 ];
+  XmlEscape::State state;
+  auto result = XmlEscape::EscapeBounded( "&", tiny, state );
+  test( result.consumed == 0 && result.produced == 0 && !result.isDone && state.position == 0 );
+
+  result = XmlEscape::EscapeBounded( "", tiny, state );
+  test( result.isDone && result.produced == 0 );
+
+  wchar_t wide[ 64 ];
+  XmlEscapeW::State wideState;
+  auto wideResult = XmlEscapeW::EscapeBounded( L"a<b", wide, wideState );
+  test( wideResult.isDone && std::wstring_view( wide, wideResult.produced ) == L"a&lt;b" );
+}
+
+void TestLengths()
+{
+  for( std::string str : { "", "plain", "&", "<a href='x'>\"Tom\" & Jerry</a>", "&&&&<<>>''\"\"" } )
+    test( StrUtil::GetXmlSafeLength( str ) == StrUtil::GetXmlSafe( str ).size() );
+  test( StrUtilW::GetXmlSafeLength( L"a&b" ) == 7 );
+
+  std::string name( "<what?>*.txt" );
+  for( auto convert : { StrUtil::ConvertWildcards::No, StrUtil::ConvertWildcards::Yes, StrUtil::ConvertWildcards::Remove } )
+    test( StrUtil::GetGoodFileNameLength( name, convert ) == StrUtil::GetGoodFileName( name, convert ).size() );
+  test( StrUtil::GetGoodFileNameLength( "??", StrUtil::ConvertWildcards::Remove ) == 0 );
+}
+
+void TestXmlContext()
+{
+  using XmlContext = StrUtil::XmlContext;
+  std::string prose( "He said \"it's <b> & > ]]> ok\"" );
+  test( StrUtil::GetXmlSafe( prose, XmlContext::All ) == StrUtil::GetXmlSafe( prose ) );
+  test( StrUtil::GetXmlSafe( prose, XmlContext::Text ) == "He said \"it's &lt;b> &amp; > ]]&gt; ok\"" );
+  test( StrUtil::GetXmlSafe( prose, XmlContext::DoubleQuotedAttribute ) == "He said &quot;it's &lt;b> &amp; > ]]> ok&quot;" );
+  test( StrUtil::GetXmlSafe( prose, XmlContext::SingleQuotedAttribute ) == "He said \"it&apos;s &lt;b> &amp; > ]]> ok\"" );
+  test( StrUtil::GetXmlSafe( "]]]>>]]", XmlContext::Text ) == "]]]&gt;>]]" );
+  test( StrUtil::GetXmlSafe( ">", XmlContext::Text ) == ">" );
+
+  for( auto context : { XmlContext::All, XmlContext::Text, XmlContext::DoubleQuotedAttribute, XmlContext::SingleQuotedAttribute } )
+  {
+    for( std::string str : { prose, std::string( "]]>]]>" ), std::string( "" ), std::string( "'\"'" ) } )
+      test( StrUtil::GetXmlSafeLength( str, context ) == StrUtil::GetXmlSafe( str, context ).size() );
+  }
+
+  std::string quoted( "'single'" );
+  StrUtil::ToXmlSafe( quoted, XmlContext::DoubleQuotedAttribute );
+  test( quoted == "'single'" );
+  StrUtil::ToXmlSafe( quoted, XmlContext::SingleQuotedAttribute );
+  test( quoted == "&apos;single&apos;" );
+  test( StrUtilW::GetXmlSafe( L"a\"b'", StrUtilW::XmlContext::Text ) == L"a\"b'" );
+}
+
+void TestXmlUnescape()
+{
+  std::string xml( "<a href='x'>\"Tom\" & Jerry</a>" );
+  test( StrUtil::GetXmlUnescaped( StrUtil::GetXmlSafe( xml ) ) == xml );
+  test( StrUtil::GetXmlUnescaped( "no entities" ) == "no entities" );
+  test( StrUtil::GetXmlUnescaped( "" ).empty() );
+
+  std::string numeric( "&#65;&#x42;&#X63;-&#233;&#x20AC;&#x1F600;" );
+  test( StrUtil::ToXmlUnescaped( numeric ) );
+  test( numeric == "ABc-\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" );
+
+  std::wstring wide( L"&lt;&#x1F600;&gt;" );
+  test( StrUtilW::ToXmlUnescaped( wide ) );
+  if constexpr( sizeof( wchar_t ) == 2 )
+    test( wide == L"<\xD83D\xDE00>" );
+  else
+    test( wide == std::wstring( L"<" ) + wchar_t( 0x1F600 ) + L">" );
+
+  // Malformed and unknown references are left as is
+  std::string bad( "&nbsp; & &#; &#xZ; &#0; &#xD800; &#x110000; &amp &amp;" );
+  test( !StrUtil::ToXmlUnescaped( bad ) );
+  test( bad == "&nbsp; & &#; &#xZ; &#0; &#xD800; &#x110000; &amp &" );
+
+  // In-buffer decoding
+  char buffer[] = "1 &lt; 2";
+  size_t size = sizeof( buffer ) - 1;
+  test( StrUtil::ToXmlUnescaped( buffer, size ) );
+  test( std::string_view( buffer, size ) == "1 < 2" );
+}
+
+void TestJson()
+{
+  test( StrUtil::GetJsonSafe( "plain" ) == "plain" );
+  test( StrUtil::GetJsonSafe( "" ).empty() );
+  test( StrUtil::GetJsonSafe( "say \"hi\"\\n" ) == "say \\\"hi\\\"\\\\n" );
+  test( StrUtil::GetJsonSafe( "a\tb\nc\rd\be\ff" ) == "a\\tb\\nc\\rd\\be\\ff" );
+  test( StrUtil::GetJsonSafe( std::string( "\x01\x1F", 2 ) ) == "\\u0001\\u001f" );
+
+  // Non-ASCII is kept by default and escaped on request
+  std::string utf8( "caf\xC3\xA9 \xF0\x9F\x98\x80" );
+  test( StrUtil::GetJsonSafe( utf8 ) == utf8 );
+  test( StrUtil::GetJsonSafe( utf8, StrUtil::EscapeNonAscii::Yes ) == "caf\\u00e9 \\ud83d\\ude00" );
+  test( StrUtil::GetJsonSafe( "\xFF\xC3", StrUtil::EscapeNonAscii::Yes ) == "\\ufffd\\ufffd" );
+  test( StrUtil::GetJsonSafe( "\xE0\x80\x80", StrUtil::EscapeNonAscii::Yes ) == "\\ufffd\\ufffd\\ufffd" );
+  test( StrUtilW::GetJsonSafe( L"\u00e9\"", StrUtilW::EscapeNonAscii::Yes ) == L"\\u00e9\\\"" );
+
+  std::string json( "{\"name\":\"" );
+  StrUtil::AppendJsonSafe( json, "C:\\temp" );
+  json += "\"}";
+  test( json == "{\"name\":\"C:\\\\temp\"}" );
+
+  std::string inPlace( "line\n" );
+  StrUtil::ToJsonSafe( inPlace );
+  test( inPlace == "line\\n" );
+  std::string clean( "clean" );
+  StrUtil::ToJsonSafe( clean );
+  test( clean == "clean" );
+
+  // Specials at every position of the block scan and its tail
+  for( size_t at = 0; at < 40; ++at )
+  {
+    for( char special : { '\"', '\\', '\x1F', '\0', '\x80' } )
+    {
+      std::string text( 40, 'x' );
+      text[ at ] = special;
+      auto escapeNonAscii = ( special == '\x80' ) ? StrUtil::EscapeNonAscii::Yes : StrUtil::EscapeNonAscii::No;
+      auto expected = text.substr( 0, at ) + StrUtil::GetJsonSafe( std::string( 1, special ), escapeNonAscii ) + text.substr( at + 1 );
+      test( StrUtil::GetJsonSafe( text, escapeNonAscii ) == expected );
+    }
+    std::wstring wide( 40, L'x' );
+    wide[ at ] = L'\n';
+    test( StrUtilW::GetJsonSafe( wide ) == wide.substr( 0, at ) + L"\\n" + wide.substr( at + 1 ) );
+  }
+  test( StrUtil::GetJsonSafe( std::string( 40, '\x7F' ) ) == std::string( 40, '\x7F' ) );
+
+  if constexpr( sizeof( wchar_t ) == 4 )
+    test( StrUtilW::GetJsonSafe( std::wstring( 1, wchar_t( 0x110000 ) ), StrUtilW::EscapeNonAscii::Yes ) == L"\\ufffd" );
+}
+
+void TestUrl()
+{
+  test( CharUtil::IsUrlUnreserved( '~' ) && !CharUtil::IsUrlUnreserved( '/' ) && !CharUtil::IsUrlUnreserved( '\x80' ) );
+  test( StrUtil::GetUrlEncoded( "Safe-Name_1.txt~" ) == "Safe-Name_1.txt~" );
+  test( StrUtil::GetUrlEncoded( "a b/c?d=e&f" ) == "a%20b%2Fc%3Fd%3De%26f" );
+  test( StrUtil::GetUrlEncoded( "caf\xC3\xA9" ) == "caf%C3%A9" );
+  test( StrUtil::GetUrlEncoded( "" ).empty() );
+  test( StrUtilW::GetUrlEncoded( L"caf\u00e9 \u20ac" ) == L"caf%C3%A9%20%E2%82%AC" );
+
+  for( std::string str : { "", "plain", "a b/c?d=e&f", "caf\xC3\xA9 100%" } )
+  {
+    test( StrUtil::GetUrlEncodedLength( str ) == StrUtil::GetUrlEncoded( str ).size() );
+    test( StrUtil::GetUrlDecoded( StrUtil::GetUrlEncoded( str ) ) == str );
+  }
+  std::wstring wide( L"\u00e9\u20ac/x" );
+  test( StrUtilW::GetUrlEncodedLength( wide ) == StrUtilW::GetUrlEncoded( wide ).size() );
+  test( StrUtilW::GetUrlDecoded( StrUtilW::GetUrlEncoded( wide ) ) == wide );
+
+  // Reserved characters, including those either side of each unreserved range, at every position
+  // of the block scan and its tail
+  std::string unreserved;
+  while( unreserved.size() < 40 )
+    unreserved += "AZaz09-._~";
+  test( StrUtil::GetUrlEncoded( unreserved ) == unreserved );
+  for( size_t at = 0; at < unreserved.size(); ++at )
+  {
+    for( char reserved : { '@', '[', '`', '{', '/', ':', ' ', '\0', '\x7F', '\x80', '\xFF' } )
+    {
+      std::string text( unreserved );
+      text[ at ] = reserved;
+      auto expected = text.substr( 0, at ) + StrUtil::GetUrlEncoded( std::string( 1, reserved ) ) + text.substr( at + 1 );
+      test( StrUtil::GetUrlEncoded( text ) == expected );
+      test( StrUtil::GetUrlEncodedLength( text ) == expected.size() );
+    }
+  }
+
+  std::string name( StrUtil::GetGoodFileName( "My <Song>?.mp3", StrUtil::ConvertWildcards::Remove ) );
+  StrUtil::ToUrlEncoded( name );
+  test( name == "My%20%28Song%29.mp3" );
+  test( StrUtil::ToUrlDecoded( name ) );
+  test( name == "My (Song).mp3" );
+
+  // Malformed sequences are left as is
+  std::string bad( "100% %zz %4 %41" );
+  test( !StrUtil::ToUrlDecoded( bad ) );
+  test( bad == "100% %zz %4 A" );
+}
+
+void TestBase64()
+{
+  using namespace StringUtil;
+  auto bytes = []( std::string_view str ) { return std::span( reinterpret_cast<const uint8_t*>( str.data() ), str.size() ); };
+
+  // RFC 4648 test vectors
+  const std::pair<std::string_view, std::string_view> vectors[] = {
+    { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+    { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" } };
+  for( auto [plain, base64] : vectors )
+  {
+    test( GetBase64( bytes( plain ) ) == base64 );
+    test( GetBase64Length( plain.size() ) == base64.size() );
+    std::vector<uint8_t> decoded;
+    test( AppendBase64Decoded( decoded, base64 ) );
+    test( std::string( decoded.begin(), decoded.end() ) == plain );
+  }
+
+  const uint8_t binary[] = { 0xFB, 0xFF, 0x00, 0x3E };
+  test( GetBase64( binary ) == "+/8APg==" );
+  test( GetBase64( binary, Base64Alphabet::UrlSafe ) == "-_8APg" );
+  test( GetBase64Length( 4, Base64Alphabet::UrlSafe ) == 6 );
+  std::vector<uint8_t> decoded;
+  test( AppendBase64Decoded( decoded, "-_8APg", Base64Alphabet::UrlSafe ) );
+  test( AppendBase64Decoded( decoded, "-_8APg==", Base64Alphabet::UrlSafe ) );
+  test( decoded.size() == 8 && std::equal( binary, binary + 4, decoded.begin() + 4 ) );
+
+  // Strict rejects anything non-canonical and leaves the output unchanged
+  for( std::string_view bad : { "Zg", "Zg=", "Zg===", "Zh==", "Z===", "Zm9v\n", "Zg==Zg==", "-_8APg==", "Zm9*" } )
+    test( !AppendBase64Decoded( decoded, bad ) );
+  test( !AppendBase64Decoded( decoded, "+/8APg==", Base64Alphabet::UrlSafe ) );
+  test( decoded.size() == 8 );
+
+  // Lenient skips whitespace and accepts either alphabet and missing padding
+  decoded.clear();
+  test( AppendBase64Decoded( decoded, " Zm9v\r\nYmFy\n", Base64Alphabet::Standard, DecodeMode::Lenient ) );
+  test( AppendBase64Decoded( decoded, "-_8APg", Base64Alphabet::Standard, DecodeMode::Lenient ) );
+  test( decoded.size() == 10 && std::equal( binary, binary + 4, decoded.begin() + 6 ) );
+  test( !AppendBase64Decoded( decoded, "Zg==Zg", Base64Alphabet::Standard, DecodeMode::Lenient ) );
+
+  // Caller buffers
+  char encoded[ 8 ];
+  test( Base64Encode( bytes( "foob" ), encoded ) == 8 );
+  uint8_t out[ 4 ];
+  size_t size = sizeof( out );
+  test( Base64Decode( std::string_view( encoded, 8 ), out, size ) && size == 4 );
+  size = 3;
+  test( !Base64Decode( std::string_view( encoded, 8 ), out, size ) );
+
+  // Hex
+  test( GetHex( binary ) == "fbff003e" );
+  test( GetHex( {} ).empty() );
+  decoded.clear();
+  test( AppendHexDecoded( decoded, "FBff003E" ) );
+  test( decoded.size() == 4 && std::equal( binary, binary + 4, decoded.begin() ) );
+  test( !AppendHexDecoded( decoded, "fbf" ) );
+  test( !AppendHexDecoded( decoded, "fb ff" ) );
+  test( !AppendHexDecoded( decoded, "0g" ) );
+  test( AppendHexDecoded( decoded, "fb ff\n00 3e", DecodeMode::Lenient ) );
+  test( decoded.size() == 8 && std::equal( binary, binary + 4, decoded.begin() + 4 ) );
+  size = 1;
+  test( !HexDecode( "fbff", out, size ) );
+
+  // Lengths spanning the vector blocks match a bit-by-bit encoding and round-trip
+  auto encodeBits = []( std::span<const uint8_t> data, std::string_view alphabet, size_t bitsPerChar )
+    {
+      std::string r;
+      for( size_t bit = 0; bit < data.size() * 8; bit += bitsPerChar )
+      {
+        size_t value = 0;
+        for( size_t i = bit; i < bit + bitsPerChar; ++i )
+          value = ( value << 1 ) | ( ( i < data.size() * 8 ) ? ( ( data[ i / 8 ] >> ( 7 - ( i % 8 ) ) ) & 1 ) : 0 );
+        r.push_back( alphabet[ value ] );
+      }
+      return r;
+    };
+  const std::string_view kStandard = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const std::string_view kUrlSafe = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+  std::vector<uint8_t> data;
+  for( size_t i = 0; i < 300; ++i )
+    data.push_back( static_cast<uint8_t>( ( i * 167 ) ^ ( i >> 3 ) ) );
+  for( size_t length = 0; length <= data.size(); ++length )
+  {
+    std::span<const uint8_t> source( data.data(), length );
+    auto urlSafe = encodeBits( source, kUrlSafe, 6 );
+    auto standard = encodeBits( source, kStandard, 6 ) + std::string( ( 3 - ( length % 3 ) ) % 3, '=' );
+    test( GetBase64( source ) == standard );
+    test( GetBase64( source, Base64Alphabet::UrlSafe ) == urlSafe );
+    test( GetHex( source ) == encodeBits( source, "0123456789abcdef", 4 ) );
+
+    // Exact capacity succeeds and one byte less fails
+    std::vector<uint8_t> exact( length );
+    size = length;
+    test( Base64Decode( standard, exact.data(), size ) && size == length && std::ranges::equal( exact, source ) );
+    size = length;
+    test( Base64Decode( urlSafe, exact.data(), size, Base64Alphabet::UrlSafe ) && std::ranges::equal( exact, source ) );
+    size = length;
+    test( HexDecode( GetHex( source ), exact.data(), size ) && std::ranges::equal( exact, source ) );
+    if( length != 0 )
+    {
+      size = length - 1;
+      test( !Base64Decode( standard, exact.data(), size ) );
+      size = length - 1;
+      test( !HexDecode( GetHex( source ), exact.data(), size ) );
+    }
+  }
+
+  // An invalid character anywhere fails, whichever path reaches it
+  auto base64 = GetBase64( data );
+  auto hex = GetHex( data );
+  for( size_t i = 0; i < 200; ++i )
+  {
+    decoded.clear();
+    auto bad = base64;
+    bad[ i ] = '*';
+    test( !AppendBase64Decoded( decoded, bad ) );
+    bad[ i ] = '-';
+    test( !AppendBase64Decoded( decoded, bad ) );
+    bad = hex;
+    bad[ i ] = 'g';
+    test( !AppendHexDecoded( decoded, bad ) );
+    bad[ i ] = ' ';
+    test( !AppendHexDecoded( decoded, bad ) );
+    test( decoded.empty() );
+
+    // Lenient accepts the other alphabet's symbols anywhere
+    bad = base64;
+    bad[ i ] = ( bad[ i ] == '/' ) ? '_' : '-';
+    test( AppendBase64Decoded( decoded, bad, Base64Alphabet::Standard, DecodeMode::Lenient ) );
+  }
+
+  // Lenient input with line breaks and mixed alphabets and case decodes through the vector paths
+  std::string wrapped;
+  for( size_t i = 0; i < base64.size(); i += 76 )
+    wrapped.append( base64.substr( i, 76 ) ).append( "\r\n" );
+  std::ranges::replace( wrapped, '+', '-' );
+  decoded.clear();
+  test( AppendBase64Decoded( decoded, wrapped, Base64Alphabet::Standard, DecodeMode::Lenient ) );
+  test( decoded == data );
+  std::string spaced;
+  for( size_t i = 0; i < hex.size(); i += 64 )
+    spaced.append( hex.substr( i, 64 ) ).append( "\n" );
+  std::ranges::transform( spaced, spaced.begin(), []( char c ) { return ( c >= 'a' && c <= 'f' ) ? char( c - 'a' + 'A' ) : c; } );
+  decoded.clear();
+  test( AppendHexDecoded( decoded, spaced, DecodeMode::Lenient ) );
+  test( decoded == data );
 }
 
 int __cdecl main()
@@ -199,6 +1226,29 @@ int __cdecl main()
   TestChar();
   TestString();
   TestStrList();
+  TestSplit();
+  TestStrListView();
+  TestStrListFile();
+  TestConcurrentStrList();
+  TestVersionedStrList();
+  TestStrPool();
+  TestStaticStrSet();
+  TestBloomFilter();
+  TestStrTrie();
+  TestPmr();
+  TestAppend();
+  TestViews();
+  TestPipeline();
+  TestParallel();
+  TestXmlEscapeWriter();
+  TestXmlSegments();
+  TestXmlBounded();
+  TestLengths();
+  TestXmlContext();
+  TestXmlUnescape();
+  TestJson();
+  TestUrl();
+  TestBase64();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
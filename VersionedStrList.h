@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  VersionedStrList.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+#pragma warning(push)
+#pragma warning(disable: 4324) // structure padded due to alignment specifier; intentional
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Read-mostly StrListT that is replaced as a whole. Readers take an immutable Snapshot without
+// locking; writers Publish() a new version. Reclamation is RCU style: readers register in one of
+// many cache-line-sized slots tagged by epoch parity, and a writer frees the previous version only
+// once every reader of the previous epoch has released its snapshot. Readers therefore never
+// contend on a shared reference count, but a long-lived snapshot delays the next Publish().
+
+template< typename C >
+class VersionedStrListT
+{
+private:
+
+  using strListT = StrListT< C >;
+
+  static constexpr size_t kReaderSlots = 64;
+
+  struct alignas( 64 ) ReaderSlot
+  {
+    std::atomic<size_t> active[ 2 ] = {};
+  };
+
+public:
+
+  // Read-only view of one version; keep it only as long as needed
+  class Snapshot
+  {
+  public:
+
+    Snapshot( const Snapshot& ) = delete;
+    Snapshot& operator=( const Snapshot& ) = delete;
+
+    Snapshot( Snapshot&& rhs ) noexcept :
+      list_( std::exchange( rhs.list_, nullptr ) ),
+      active_( std::exchange( rhs.active_, nullptr ) )
+    {
+    }
+
+    Snapshot& operator=( Snapshot&& rhs ) noexcept
+    {
+      if( this != &rhs )
+      {
+        Release();
+        list_ = std::exchange( rhs.list_, nullptr );
+        active_ = std::exchange( rhs.active_, nullptr );
+      }
+      return *this;
+    }
+
+    ~Snapshot()
+    {
+      Release();
+    }
+
+    const strListT& operator*() const { return *list_; }
+    const strListT* operator->() const { return list_; }
+
+  private:
+
+    friend class VersionedStrListT;
+
+    Snapshot( const strListT* list, std::atomic<size_t>* active ) :
+      list_( list ),
+      active_( active )
+    {
+    }
+
+    void Release()
+    {
+      if( active_ != nullptr )
+        active_->fetch_sub( 1, std::memory_order_release );
+      active_ = nullptr;
+      list_ = nullptr;
+    }
+
+  private:
+
+    const strListT*      list_;
+    std::atomic<size_t>* active_;
+
+  }; // Snapshot
+
+public:
+
+  VersionedStrListT( const VersionedStrListT& ) = delete;
+  VersionedStrListT& operator=( const VersionedStrListT& ) = delete;
+
+  explicit VersionedStrListT( strListT strList = {} ) :
+    current_( new strListT( std::move( strList ) ) )
+  {
+  }
+
+  ~VersionedStrListT()
+  {
+    delete current_.load();
+  }
+
+  // Lock-free; safe to call from any number of threads
+  Snapshot GetSnapshot() const
+  {
+    auto& slot = readers_[ GetReaderSlot() ];
+    for( ;; )
+    {
+      // Register under the current epoch, then confirm no writer flipped it in the meantime
+      auto epoch = epoch_.load();
+      auto& active = slot.active[ epoch & 1 ];
+      active.fetch_add( 1 );
+      if( epoch_.load() == epoch )
+        return Snapshot( current_.load(), &active );
+      active.fetch_sub( 1, std::memory_order_release );
+    }
+  }
+
+  // Replace the list. New snapshots see strList immediately; the previous version is destroyed
+  // after its last reader releases. Writers are serialized.
+  void Publish( strListT strList )
+  {
+    std::lock_guard<std::mutex> lock( writer_ );
+    auto* previous = current_.exchange( new strListT( std::move( strList ) ) );
+    auto epoch = epoch_.fetch_add( 1 );
+
+    for( auto& slot : readers_ )
+    {
+      while( slot.active[ epoch & 1 ].load( std::memory_order_acquire ) != 0 )
+        std::this_thread::yield();
+    }
+    delete previous;
+  }
+
+  // Number of times Publish() has been called
+  uint64_t GetVersion() const
+  {
+    return epoch_.load( std::memory_order_relaxed );
+  }
+
+private:
+
+  // Threads are assigned slots round robin the first time they read
+  static size_t GetReaderSlot()
+  {
+    static std::atomic<size_t> nextSlot = 0;
+    thread_local const size_t slot = nextSlot.fetch_add( 1, std::memory_order_relaxed ) % kReaderSlots;
+    return slot;
+  }
+
+private:
+
+  std::atomic<const strListT*> current_;
+  std::atomic<uint64_t>        epoch_ = 0;
+  std::mutex                   writer_;
+  mutable std::array<ReaderSlot, kReaderSlots> readers_ = {};
+
+}; // VersionedStrListT
+
+#pragma warning(pop)
+
+using VersionedStrList = VersionedStrListT<char>;
+using VersionedStrListW = VersionedStrListT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  XmlEscape.h
+//
+//  Copyright  Pete Isensee (PKIsensee@msn.com).
+//  All rights reserved worldwide.
+//
+//  Permission to copy, modify, reproduce or redistribute this source code is granted provided the
+//  above copyright notice is retained in the resulting source code.
+//
+//  This software is provided "as is" and without any express or implied warranties.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined( _WIN32 )
+#include <io.h>
+#else
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "StrUtil.h"
+
+namespace PKIsensee
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Sinks for XmlEscapeWriterT. A sink is any callable taking ( const C* data, size_t count ) and
+// returning false on failure.
+
+// Writes to a C stream opened in binary mode
+struct FileSink
+{
+  FILE* file;
+
+  template< typename C >
+  bool operator()( const C* data, size_t count ) const
+  {
+    return fwrite( data, sizeof( C ), count, file ) == count;
+  }
+};
+
+// Writes to a file descriptor or socket, retrying partial writes
+struct FdSink
+{
+  int fd;
+
+  template< typename C >
+  bool operator()( const C* data, size_t count ) const
+  {
+    auto bytes = reinterpret_cast<const char*>( data );
+    size_t remaining = count * sizeof( C );
+    while( remaining > 0 )
+    {
+#if defined( _WIN32 )
+      auto written = _write( fd, bytes, static_cast<unsigned>( std::min( remaining, size_t( 1u << 30 ) ) ) );
+#else
+      auto written = ::write( fd, bytes, remaining );
+      if( written < 0 && errno == EINTR )
+        continue;
+#endif
+      if( written <= 0 )
+        return false;
+      bytes += written;
+      remaining -= static_cast<size_t>( written );
+    }
+    return true;
+  }
+};
+
+template< typename C >
+struct OStreamSinkT
+{
+  std::basic_ostream<C>* stream;
+
+  bool operator()( const C* data, size_t count ) const
+  {
+    stream->write( data, static_cast<std::streamsize>( count ) );
+    return !stream->fail();
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Streams XML-safe output to a sink through a fixed internal buffer, so inputs of any size are
+// escaped in constant memory without building the escaped string. Runs larger than the buffer
+// are passed to the sink directly. Once the sink fails, further output is discarded and every
+// call returns false.
+//
+//    XmlEscapeWriter<FileSink> writer( FileSink{ file } );
+//    writer.WriteRaw( "<name>" );
+//    writer.Write( name );
+//    writer.WriteRaw( "</name>" );
+
+template< typename C, typename Sink >
+class XmlEscapeWriterT
+{
+private:
+
+  using viewT = std::basic_string_view< C >;
+
+  static constexpr size_t kBufferSize = 4096; // characters
+
+public:
+
+  explicit XmlEscapeWriterT( Sink sink ) :
+    sink_( std::move( sink ) )
+  {
+  }
+
+  XmlEscapeWriterT( const XmlEscapeWriterT& ) = delete;
+  XmlEscapeWriterT& operator=( const XmlEscapeWriterT& ) = delete;
+
+  ~XmlEscapeWriterT()
+  {
+    Flush();
+  }
+
+  // Escape str and write it
+  bool Write( viewT str, typename StrUtilT<C>::XmlContext context = StrUtilT<C>::XmlContext::All )
+  {
+    StrUtilT<C>::EscapeXml( str, [this]( viewT run ) { Put( run ); }, context );
+    return isOk_;
+  }
+
+  // Write str as is, e.g. for markup
+  bool WriteRaw( viewT str )
+  {
+    Put( str );
+    return isOk_;
+  }
+
+  // Pass any buffered output to the sink
+  bool Flush()
+  {
+    if( used_ != 0 && isOk_ )
+      isOk_ = sink_( buffer_.data(), used_ );
+    used_ = 0;
+    return isOk_;
+  }
+
+  bool IsOk() const
+  {
+    return isOk_;
+  }
+
+private:
+
+  void Put( viewT run )
+  {
+    if( run.size() > kBufferSize - used_ )
+    {
+      Flush();
+      if( run.size() >= kBufferSize )
+      {
+        if( isOk_ )
+          isOk_ = sink_( run.data(), run.size() );
+        return;
+      }
+    }
+    std::char_traits<C>::copy( buffer_.data() + used_, run.data(), run.size() );
+    used_ += run.size();
+  }
+
+private:
+
+  Sink                       sink_;
+  std::array<C, kBufferSize> buffer_;
+  size_t                     used_ = 0;
+  bool                       isOk_ = true;
+
+}; // XmlEscapeWriterT
+
+template< typename Sink >
+using XmlEscapeWriter = XmlEscapeWriterT<char, Sink>;
+template< typename Sink >
+using XmlEscapeWriterW = XmlEscapeWriterT<wchar_t, Sink>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// XML escaping without copying the input
+
+template< typename C >
+class XmlEscapeT
+{
+private:
+
+  using viewT = std::basic_string_view< C >;
+
+public:
+
+  // Longest markup for a single character; bounded output buffers must be at least this large
+  static constexpr size_t kMaxCodeLength = []()
+    {
+      size_t longest = 0;
+      for( const auto& specialXml : kXmlReplace )
+        longest = std::max( longest, std::char_traits<char>::length( specialXml.xmlCode ) );
+      return longest;
+    }();
+
+  // Progress through one input string across calls to EscapeBounded
+  struct State
+  {
+    size_t position = 0; // input characters consumed so far
+  };
+
+  struct Result
+  {
+    size_t consumed;  // input characters consumed by this call
+    size_t produced;  // output characters written by this call
+    bool   isDone;    // the whole input has been escaped
+  };
+
+  // Escape as much of str as fits in out, resuming from state, which is advanced. Markup for a
+  // character is never split across calls, so each call's output is complete XML text and can be
+  // sent as is, e.g. as one network frame. Output of at least kMaxCodeLength characters always
+  // makes progress. Pass the same str and state until isDone.
+  static Result EscapeBounded( viewT str, std::span<C> out, State& state )
+  {
+    size_t pos = std::min( state.position, str.size() );
+    size_t produced = 0;
+    while( pos < str.size() )
+    {
+      // Clean runs can be split anywhere
+      auto special = std::min( str.find_first_of( StrUtilT<C>::GetXmlSymbols(), pos ), str.size() );
+      auto runLength = std::min( special - pos, out.size() - produced );
+      std::char_traits<C>::copy( out.data() + produced, str.data() + pos, runLength );
+      pos += runLength;
+      produced += runLength;
+      if( pos != special || pos == str.size() )
+        break;
+
+      auto code = StrUtilT<C>::GetXmlCode( str[ pos ] );
+      if( code.size() > out.size() - produced )
+        break;
+      std::char_traits<C>::copy( out.data() + produced, code.data(), code.size() );
+      produced += code.size();
+      ++pos;
+    }
+
+    Result result = { pos - state.position, produced, pos == str.size() };
+    state.position = pos;
+    return result;
+  }
+
+  // Append the XML-safe version of str to segments as a list of views: unchanged runs of str
+  // interleaved with the static markup from kXmlReplace. Nothing is copied, so a mostly clean
+  // payload costs a handful of segments. The segments refer into str, which must outlive them.
+  static void GetSegments( viewT str, std::vector<viewT>& segments )
+  {
+    StrUtilT<C>::EscapeXml( str, [&segments]( viewT run ) { segments.push_back( run ); } );
+  }
+
+  // Write segments to a file descriptor or socket with as few system calls as possible
+  static bool WriteSegments( int fd, std::span<const viewT> segments )
+  {
+#if defined( _WIN32 )
+    FdSink sink{ fd };
+    return std::ranges::all_of( segments, [&sink]( viewT segment ) { return sink( segment.data(), segment.size() ); } );
+#else
+    constexpr size_t kMaxBatch = 64;
+    size_t index = 0;
+    size_t offset = 0; // bytes of segments[ index ] already written
+    for( ;; )
+    {
+      while( index < segments.size() && segments[ index ].empty() )
+        ++index;
+      if( index == segments.size() )
+        return true;
+
+      iovec batch[ kMaxBatch ];
+      int count = 0;
+      for( size_t i = index; i < segments.size() && count < int( kMaxBatch ); ++i )
+      {
+        if( segments[ i ].empty() )
+          continue;
+        auto skip = ( i == index ) ? offset : 0;
+        batch[ count ].iov_base = const_cast<char*>( reinterpret_cast<const char*>( segments[ i ].data() ) + skip );
+        batch[ count ].iov_len = ( segments[ i ].size() * sizeof( C ) ) - skip;
+        ++count;
+      }
+
+      auto written = ::writev( fd, batch, count );
+      if( written < 0 && errno == EINTR )
+        continue;
+      if( written <= 0 )
+        return false;
+
+      // Step past everything written, which may end partway through a segment
+      auto remaining = static_cast<size_t>( written );
+      while( remaining > 0 )
+      {
+        auto left = ( segments[ index ].size() * sizeof( C ) ) - offset;
+        if( remaining < left )
+        {
+          offset += remaining;
+          break;
+        }
+        remaining -= left;
+        offset = 0;
+        ++index;
+      }
+    }
+#endif
+  }
+
+}; // XmlEscapeT
+
+using XmlEscape = XmlEscapeT<char>;
+using XmlEscapeW = XmlEscapeT<wchar_t>;
+
+} // PKIsensee
+
+////////////////////////////////////////////////////////////////////////////////////////////////////